@@ -0,0 +1,126 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <tablez/id.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+inline std::mt19937 &RNG() {
+    static std::mt19937 rng{42};
+    return rng;
+}
+
+inline std::string random_string(std::mt19937 &rng) {
+    std::uniform_int_distribution<char> chars{'0', 'Z'};
+    auto size = std::uniform_int_distribution<size_t>{8, 128}(rng);
+
+    std::string str;
+    str.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        str.push_back(chars(rng));
+    }
+    return str;
+}
+
+inline std::tuple<int, bool, double, std::string> generate_tuple(std::mt19937 &rng) {
+    auto i = std::uniform_int_distribution<int>{}(rng);
+    auto b = std::uniform_int_distribution<uint8_t>{0, 1}(rng);
+    auto d = std::uniform_real_distribution<double>{}(rng);
+    auto s = random_string(rng);
+    return {i, b, d, std::move(s)};
+}
+
+inline std::vector<std::tuple<int, bool, double, std::string>> generate_data(std::mt19937 &rng, size_t size) {
+    std::vector<std::tuple<int, bool, double, std::string>> vec;
+    vec.reserve(size);
+    for (size_t idx = 0; idx < size; ++idx) {
+        vec.emplace_back(generate_tuple(rng));
+    }
+
+    return vec;
+}
+
+// row of baselines, same columns as tables of the suite
+struct Row {
+    int i;
+    bool b;
+    double d;
+    std::string s;
+};
+
+struct IdHash {
+    size_t operator()(tablez::Id id) const noexcept {
+        return std::hash<uint64_t>{}((uint64_t{id.gen()} << 32) | id.idx());
+    }
+};
+
+// hardware counters of the calling thread through perf_event_open, reported per iteration once it goes out
+//   of scope. Does nothing where perf events are unavailable, e.g. with kernel.perf_event_paranoid > 2 or
+//   in containers. Counts from construction on, thus create it right before the benchmark loop
+class PerfCounters {
+public:
+    explicit PerfCounters(benchmark::State &state) : state_{state} {
+#ifdef __linux__
+        open(0, PERF_COUNT_HW_CACHE_MISSES);
+        open(1, PERF_COUNT_HW_BRANCH_MISSES);
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    ~PerfCounters() {
+#ifdef __linux__
+        static constexpr const char *NAMES[] = {"cache_misses", "branch_misses"};
+        for (int i = 0; i < 2; ++i) {
+            if (fds_[i] < 0) {
+                continue;
+            }
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t value = 0;
+            if (read(fds_[i], &value, sizeof(value)) == sizeof(value)) {
+                state_.counters[NAMES[i]] = benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+            }
+            close(fds_[i]);
+        }
+#endif
+    }
+
+private:
+#ifdef __linux__
+    void open(int at, uint64_t config) {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fds_[at] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    int fds_[2] = {-1, -1};
+#endif
+    benchmark::State &state_;
+};
+}  // namespace bench
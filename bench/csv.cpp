@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/csv.h>
+
+#include <string>
+
+namespace {
+
+std::string make_csv(size_t rows) {
+    std::string text = "id,value,name\n";
+    for (size_t i = 0; i < rows; ++i) {
+        text += std::to_string(i) + ',' + std::to_string(i * 0.25) + ",name" + std::to_string(i % 100) + '\n';
+    }
+    return text;
+}
+
+void BM_ParseCsv(benchmark::State &state) {
+    auto text = make_csv(1 << 20);
+    tablez::dense::CsvOptions options{.threads = static_cast<uint32_t>(state.range(0))};
+
+    for (auto _ : state) {
+        auto table = tablez::dense::parse_csv<int64_t, double, std::string>(text, options);
+        benchmark::DoNotOptimize(table->count());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK(BM_ParseCsv)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/dynamic_table.h>
+#include <tablez/dense/table.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "common.h"
+
+// scans of runtime schema table against hand written loops over the templated one with the same columns
+
+namespace {
+
+using tablez::dense::ColumnType;
+using tablez::dense::Compare;
+using tablez::dense::DynamicSpan;
+using tablez::dense::DynamicTable;
+
+struct Data {
+    std::vector<int32_t> ints;
+    std::vector<double> doubles;
+};
+
+Data make_data(size_t size) {
+    Data data;
+    std::uniform_int_distribution<int32_t> ints{0, 999};
+    for (size_t i = 0; i < size; ++i) {
+        data.ints.push_back(ints(bench::RNG()));
+        data.doubles.push_back(i * 0.5);
+    }
+    return data;
+}
+
+DynamicTable make_dynamic(const Data &data) {
+    DynamicTable table({{"int", ColumnType::Int32}, {"double", ColumnType::Double}});
+    std::vector<DynamicSpan> columns{std::span<const int32_t>{data.ints}, std::span<const double>{data.doubles}};
+    table.insert_many(columns);
+    return table;
+}
+
+tablez::dense::Table<int32_t, double> make_typed(Data data) {
+    tablez::dense::Table<int32_t, double> table;
+    table.insert_many(data.ints, data.doubles);
+    return table;
+}
+
+void BM_DynamicSum(benchmark::State &state) {
+    auto table = make_dynamic(make_data(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.aggregate(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_TypedSum(benchmark::State &state) {
+    auto table = make_typed(make_data(state.range(0)));
+    for (auto _ : state) {
+        auto values = table.values<int32_t>();
+        int64_t sum = 0;
+        int32_t lo = values[0];
+        int32_t hi = values[0];
+        for (int32_t value : values) {
+            sum += value;
+            lo = std::min(lo, value);
+            hi = std::max(hi, value);
+        }
+        benchmark::DoNotOptimize(sum + lo + hi);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_DynamicFilter(benchmark::State &state) {
+    auto table = make_dynamic(make_data(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.filter(0, Compare::Less, int32_t{100}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_TypedFilter(benchmark::State &state) {
+    auto table = make_typed(make_data(state.range(0)));
+    for (auto _ : state) {
+        std::vector<tablez::Id> res;
+        auto values = table.values<int32_t>();
+        auto ids = table.ids();
+        for (uint32_t row = 0; row < values.size(); ++row) {
+            if (values[row] < 100) {
+                res.push_back(ids[row]);
+            }
+        }
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_DynamicSum)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_TypedSum)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_DynamicFilter)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_TypedFilter)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+}  // namespace
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/table.h>
+#include <tablez/group_by.h>
+
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+constexpr uint32_t ROWS = 1 << 22;
+constexpr uint32_t GROUPS = 100000;
+
+tablez::dense::Table<uint32_t, int64_t> make_table() {
+    auto table = tablez::dense::Table<uint32_t, int64_t>::with_capacity(ROWS);
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<uint32_t> key{0, GROUPS - 1};
+    for (uint32_t i = 0; i < ROWS; ++i) {
+        table.insert(key(rng), int64_t{i});
+    }
+    return table;
+}
+
+void BM_GroupByUnorderedMap(benchmark::State &state) {
+    auto table = make_table();
+
+    for (auto _ : state) {
+        std::unordered_map<uint32_t, tablez::Group<uint32_t, int64_t>> groups;
+        table.for_each_row([&](tablez::Id, uint32_t &key, int64_t &value) { groups[key].add(value); });
+        benchmark::DoNotOptimize(groups.size());
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+void BM_GroupBy(benchmark::State &state) {
+    auto table = make_table();
+
+    for (auto _ : state) {
+        auto groups = tablez::group_by<uint32_t, int64_t>(table, state.range(0));
+        benchmark::DoNotOptimize(groups.size());
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+BENCHMARK(BM_GroupByUnorderedMap)->UseRealTime();
+BENCHMARK(BM_GroupBy)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+}  // namespace
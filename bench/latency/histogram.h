@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace latency {
+
+// log-linear buckets the way HdrHistogram does it: values below SUB_COUNT are exact, above that every
+//   power of two range is split into SUB_COUNT buckets, thus relative error stays below 1 / SUB_COUNT
+class Histogram {
+public:
+    static constexpr uint32_t SUB_BITS = 7;
+    static constexpr uint32_t SUB_COUNT = 1 << SUB_BITS;
+
+    Histogram() : counts_((65 - SUB_BITS) * SUB_COUNT) {}
+
+    void record(uint64_t value) noexcept {
+        ++counts_[bucket_of(value)];
+        ++count_;
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const Histogram &rhs) noexcept {
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += rhs.counts_[i];
+        }
+        count_ += rhs.count_;
+        max_ = std::max(max_, rhs.max_);
+    }
+
+    // the highest value of bucket holding q-th quantile, q in [0, 1]
+    uint64_t percentile(double q) const noexcept {
+        uint64_t rank = std::max<uint64_t>(1, std::ceil(q * count_));
+        uint64_t seen = 0;
+        for (uint32_t bucket = 0; bucket < counts_.size(); ++bucket) {
+            seen += counts_[bucket];
+            if (seen >= rank) {
+                return std::min(highest_of(bucket), max_);
+            }
+        }
+        return max_;
+    }
+
+    uint64_t count() const noexcept { return count_; }
+
+    uint64_t max() const noexcept { return max_; }
+
+private:
+    static uint32_t bucket_of(uint64_t value) noexcept {
+        if (value < SUB_COUNT) {
+            return value;
+        }
+        uint32_t shift = std::bit_width(value) - 1 - SUB_BITS;  // value >> shift is in [SUB_COUNT, 2 * SUB_COUNT)
+        return (shift + 1) * SUB_COUNT + ((value >> shift) - SUB_COUNT);
+    }
+
+    static uint64_t highest_of(uint32_t bucket) noexcept {
+        if (bucket < SUB_COUNT) {
+            return bucket;
+        }
+        uint32_t shift = bucket / SUB_COUNT - 1;
+        uint64_t sub = bucket % SUB_COUNT + SUB_COUNT;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    uint64_t max_ = 0;
+};
+}  // namespace latency
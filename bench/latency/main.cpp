@@ -0,0 +1,153 @@
+#include <tablez/dense/table.h>
+#include <tablez/sparse/table.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "histogram.h"
+
+// latency of single table operations under sustained load at a fixed rate, as percentiles per table type
+//   and column mix. Throughput benchmarks average growth spikes of reserve_at_least away, this doesn't.
+//   Tables start prefilled and grow over the run, as half of operations are inserts, 30% removes and the
+//   rest lookups of random alive rows
+//
+// usage: tablez_latency [--rate=operations per second] [--seconds=per table] [--rows=prefilled rows]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using latency::Histogram;
+
+struct Options {
+    double rate = 200000;
+    double seconds = 1;
+    uint32_t rows = 100000;
+};
+
+enum Op { INSERT, REMOVE, LOOKUP, OPS };
+constexpr const char *OP_NAMES[OPS] = {"insert", "remove", "lookup"};
+
+struct Report {
+    Histogram ops[OPS];  // time taken by operation itself
+    Histogram response;  // from scheduled start to end, includes waiting behind slow operations before
+    double achieved_rate = 0;
+};
+
+uint64_t ns_between(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+// longer than small string optimization holds
+std::string make_string(uint64_t i) { return "row " + std::to_string(i) + std::string(24, '.'); }
+
+template <class Table, class MakeRow>
+Report run(const Options &opts, MakeRow &&make_row) {
+    Table table;
+    std::mt19937 rng{42};
+    std::vector<tablez::Id> ids;
+    ids.reserve(opts.rows);
+    auto insert = [&](uint64_t i) {
+        return std::apply([&](auto &&...values) { return table.insert(std::move(values)...); }, make_row(i));
+    };
+    for (uint32_t i = 0; i < opts.rows; ++i) {
+        ids.push_back(insert(i));
+    }
+
+    Report report;
+    uint64_t total = opts.rate * opts.seconds;
+    double period_ns = 1e9 / opts.rate;
+    uint64_t sink = 0;
+    std::uniform_int_distribution<uint32_t> percent{0, 99};
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < total; ++i) {
+        uint32_t roll = percent(rng);
+        Op op = ids.empty() || roll < 50 ? INSERT : roll < 80 ? REMOVE : LOOKUP;
+        size_t at = ids.empty() ? 0 : std::uniform_int_distribution<size_t>{0, ids.size() - 1}(rng);
+        auto row = make_row(opts.rows + i);
+
+        auto scheduled = start + std::chrono::nanoseconds(static_cast<uint64_t>(i * period_ns));
+        while (Clock::now() < scheduled) {
+            // spin, sleeps are too coarse for periods of microseconds
+        }
+
+        auto begin = Clock::now();
+        if (op == INSERT) {
+            ids.push_back(std::apply([&](auto &&...values) { return table.insert(std::move(values)...); }, row));
+        } else if (op == REMOVE) {
+            sink += table.remove(ids[at]);
+        } else {
+            sink += table.template try_get<int>(ids[at]) != nullptr;
+        }
+        auto end = Clock::now();
+
+        if (op == REMOVE) {
+            ids[at] = ids.back();
+            ids.pop_back();
+        }
+        report.ops[op].record(ns_between(begin, end));
+        report.response.record(ns_between(scheduled, end));
+    }
+    report.achieved_rate = total / (ns_between(start, Clock::now()) / 1e9);
+    if (sink == UINT64_MAX) {
+        std::printf("\n");  // keeps results alive
+    }
+    return report;
+}
+
+void print_line(const char *table, const char *op, const Histogram &histogram) {
+    std::printf("%-28s %-9s %10lu %9lu %9lu %9lu %11lu\n", table, op, histogram.count(), histogram.percentile(0.5),
+                histogram.percentile(0.99), histogram.percentile(0.999), histogram.max());
+}
+
+template <class Table, class MakeRow>
+void report(const Options &opts, const char *name, MakeRow &&make_row) {
+    Report report = run<Table>(opts, make_row);
+    for (int op = 0; op < OPS; ++op) {
+        print_line(name, OP_NAMES[op], report.ops[op]);
+    }
+    print_line(name, "response", report.response);
+    std::printf("%-28s achieved %.0f ops/s\n", name, report.achieved_rate);
+}
+
+bool parse(int argc, char **argv, Options &opts) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&](std::string_view prefix) { return std::string{arg.substr(prefix.size())}; };
+        if (arg.starts_with("--rate=")) {
+            opts.rate = std::stod(value("--rate="));
+        } else if (arg.starts_with("--seconds=")) {
+            opts.seconds = std::stod(value("--seconds="));
+        } else if (arg.starts_with("--rows=")) {
+            opts.rows = std::stoul(value("--rows="));
+        } else {
+            return false;
+        }
+    }
+    return opts.rate > 0 && opts.seconds > 0;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    if (!parse(argc, argv, opts)) {
+        std::fprintf(stderr, "usage: %s [--rate=ops per second] [--seconds=per table] [--rows=prefilled rows]\n",
+                     argv[0]);
+        return 1;
+    }
+    std::printf("rate %.0f ops/s, %.1f s per table, %u prefilled rows, latencies in ns\n", opts.rate, opts.seconds,
+                opts.rows);
+    std::printf("%-28s %-9s %10s %9s %9s %9s %11s\n", "table", "op", "count", "p50", "p99", "p99.9", "max");
+
+    auto numbers = [](uint64_t i) { return std::tuple{static_cast<int>(i), i * 0.5}; };
+    auto strings = [](uint64_t i) { return std::tuple{static_cast<int>(i), make_string(i)}; };
+    report<tablez::dense::Table<int, double>>(opts, "dense<int, double>", numbers);
+    report<tablez::sparse::Table<int, double>>(opts, "sparse<int, double>", numbers);
+    report<tablez::dense::Table<int, std::string>>(opts, "dense<int, string>", strings);
+    report<tablez::sparse::Table<int, std::string>>(opts, "sparse<int, string>", strings);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/table.h>
+#include <tablez/sparse/table.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t BATCH = 4096;
+
+template <class Table>
+std::vector<tablez::Id> fill(Table &table, size_t size) {
+    std::vector<tablez::Id> ids;
+    ids.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        ids.push_back(table.insert(static_cast<int>(i), i * 0.5));
+    }
+    return ids;
+}
+
+std::vector<tablez::Id> random_batch(const std::vector<tablez::Id> &ids) {
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<size_t> pick{0, ids.size() - 1};
+    std::vector<tablez::Id> batch(BATCH);
+    std::generate(batch.begin(), batch.end(), [&] { return ids[pick(rng)]; });
+    return batch;
+}
+
+template <class Table>
+void lookup_one_by_one(benchmark::State &state) {
+    Table table;
+    auto batch = random_batch(fill(table, state.range(0)));
+    const Table &view = table;
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto id : batch) {
+            if (auto *value = view.template try_get<int>(id)) {
+                sum += *value;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+template <class Table>
+void lookup_get_many(benchmark::State &state) {
+    Table table;
+    auto batch = random_batch(fill(table, state.range(0)));
+    std::unique_ptr<bool[]> found{new bool[BATCH]};
+    std::vector<int> ints(BATCH);
+
+    for (auto _ : state) {
+        table.template get_many<int>(batch, {found.get(), BATCH}, ints);
+        benchmark::DoNotOptimize(ints.data());
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+void BM_DenseTableLookup(benchmark::State &state) { lookup_one_by_one<tablez::dense::Table<int, double>>(state); }
+
+void BM_DenseTableGetMany(benchmark::State &state) { lookup_get_many<tablez::dense::Table<int, double>>(state); }
+
+void BM_SparseTableLookup(benchmark::State &state) { lookup_one_by_one<tablez::sparse::Table<int, double>>(state); }
+
+void BM_SparseTableGetMany(benchmark::State &state) { lookup_get_many<tablez::sparse::Table<int, double>>(state); }
+
+BENCHMARK(BM_DenseTableLookup)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_DenseTableGetMany)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SparseTableLookup)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SparseTableGetMany)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+
+}  // namespace
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/table.h>
+
+namespace {
+
+using Table = tablez::dense::Table<int, double>;
+
+Table make_table(size_t size) {
+    Table table;
+    for (size_t i = 0; i < size; ++i) {
+        table.insert(static_cast<int>(i), 0.5 * i);
+    }
+    return table;
+}
+
+void BM_DenseTableInsertRows(benchmark::State &state) {
+    auto staging = make_table(state.range(0));
+
+    for (auto _ : state) {
+        Table table;
+        staging.for_each_row([&](tablez::Id, int &value, double &weight) { table.insert(value, weight); });
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * staging.count());
+}
+
+void BM_DenseTableMerge(benchmark::State &state) {
+    auto staging = make_table(state.range(0));
+
+    for (auto _ : state) {
+        Table table;
+        table.merge(staging);
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * staging.count());
+}
+
+void BM_DenseTableClone(benchmark::State &state) {
+    auto staging = make_table(state.range(0));
+
+    for (auto _ : state) {
+        auto table = staging.clone();
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * staging.count());
+}
+
+BENCHMARK(BM_DenseTableInsertRows)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_DenseTableMerge)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_DenseTableClone)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+}  // namespace
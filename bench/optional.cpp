@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/table.h>
+
+#include <optional>
+
+#include "common.h"
+
+// column present in range(0) percent of rows: Optional column against std::optional one
+
+namespace {
+
+template <class Table>
+Table fill(benchmark::State &state) {
+    Table table;
+    std::uniform_int_distribution<int> percent{0, 99};
+    for (uint32_t i = 0; i < (1 << 20); ++i) {
+        if (percent(bench::RNG()) < state.range(0)) {
+            table.insert(static_cast<int>(i), i * 0.5);
+        } else {
+            table.insert(static_cast<int>(i), std::nullopt);
+        }
+    }
+    return table;
+}
+
+void BM_OptionalColumnScan(benchmark::State &state) {
+    using Column = tablez::Optional<double>;
+    auto table = fill<tablez::dense::Table<int, Column>>(state);
+    for (auto _ : state) {
+        double sum = 0;
+        table.for_each<Column>([&](tablez::Id, double &value) { sum += value; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * table.count());
+}
+
+void BM_StdOptionalColumnScan(benchmark::State &state) {
+    auto table = fill<tablez::dense::Table<int, std::optional<double>>>(state);
+    for (auto _ : state) {
+        double sum = 0;
+        table.for_each<std::optional<double>>([&](tablez::Id, std::optional<double> &value) {
+            if (value) {
+                sum += *value;
+            }
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * table.count());
+}
+
+BENCHMARK(BM_OptionalColumnScan)->Arg(2)->Arg(50)->Arg(100);
+BENCHMARK(BM_StdOptionalColumnScan)->Arg(2)->Arg(50)->Arg(100);
+
+}  // namespace
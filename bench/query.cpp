@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <tablez/query.h>
+
+#include <random>
+
+namespace {
+
+template <class Table>
+Table make_table(size_t size) {
+    Table table;
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    for (size_t i = 0; i < size; ++i) {
+        table.insert(static_cast<int>(i), dist(rng));
+    }
+    return table;
+}
+
+template <class Table>
+void sum_for_each_row(benchmark::State &state) {
+    auto table = make_table<Table>(state.range(0));
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        table.for_each_row([&](tablez::Id, int &value, double &weight) {
+            if (weight > 0.5) {
+                sum += value;
+            }
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * table.count());
+}
+
+template <class Table>
+void sum_query(benchmark::State &state) {
+    auto table = make_table<Table>(state.range(0));
+
+    for (auto _ : state) {
+        auto sum = tablez::from(table).template where<double>(tablez::_ > 0.5).template select<int>().sum();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * table.count());
+}
+
+void BM_DenseSumForEachRow(benchmark::State &state) { sum_for_each_row<tablez::dense::Table<int, double>>(state); }
+
+void BM_DenseSumQuery(benchmark::State &state) { sum_query<tablez::dense::Table<int, double>>(state); }
+
+void BM_SparseSumForEachRow(benchmark::State &state) { sum_for_each_row<tablez::sparse::Table<int, double>>(state); }
+
+void BM_SparseSumQuery(benchmark::State &state) { sum_query<tablez::sparse::Table<int, double>>(state); }
+
+BENCHMARK(BM_DenseSumForEachRow)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_DenseSumQuery)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SparseSumForEachRow)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SparseSumQuery)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+}  // namespace
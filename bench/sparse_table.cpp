@@ -2,44 +2,14 @@
 #include <tablez/sparse/table.h>
 
 #include <random>
+#include "common.h"
 #include "tablez/dense/table.h"
 
 namespace {
 
-std::string random_string(std::mt19937 &rng) {
-    std::uniform_int_distribution<char> chars{'0', 'Z'};
-    auto size = std::uniform_int_distribution<size_t>{8, 128}(rng);
-
-    std::string str;
-    str.reserve(size);
-    for (size_t i = 0; i < size; ++i) {
-        str.push_back(chars(rng));
-    }
-    return str;
-}
-
-std::tuple<int, bool, double, std::string> generate_tuple(std::mt19937 &rng) {
-    auto i = std::uniform_int_distribution<int>{}(rng);
-    auto b = std::uniform_int_distribution<uint8_t>{0, 1}(rng);
-    auto d = std::uniform_real_distribution<double>{}(rng);
-    auto s = random_string(rng);
-    return {i, b, d, std::move(s)};
-}
-
-std::vector<std::tuple<int, bool, double, std::string>> generate_data(std::mt19937 &rng, size_t size) {
-    std::vector<std::tuple<int, bool, double, std::string>> vec;
-    vec.reserve(size);
-    for (size_t idx = 0; idx < size; ++idx) {
-        vec.emplace_back(generate_tuple(rng));
-    }
-
-    return vec;
-}
-
-std::mt19937 &RNG() {
-    static std::mt19937 rng{42};
-    return rng;
-}
+using bench::generate_data;
+using bench::generate_tuple;
+using bench::RNG;
 
 void BM_SparseTableInsert(benchmark::State &state) {
     tablez::sparse::Table<int, bool, double, std::string> table;
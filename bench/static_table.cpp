@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/static_table.h>
+#include <tablez/dense/table.h>
+
+#include <vector>
+
+namespace {
+
+constexpr uint32_t ROWS = 16;
+
+template <class Table>
+void sum_small_tables(benchmark::State &state) {
+    std::vector<Table> tables(state.range(0));
+    for (auto &table : tables) {
+        for (uint32_t i = 0; i < ROWS; ++i) {
+            table.insert(static_cast<int>(i));
+        }
+    }
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto &table : tables) {
+            table.template for_each<int>([&](tablez::Id, int &value) { sum += value; });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * tables.size() * ROWS);
+}
+
+void BM_DenseSmallTablesSum(benchmark::State &state) { sum_small_tables<tablez::dense::Table<int>>(state); }
+
+void BM_DenseStaticTablesSum(benchmark::State &state) {
+    sum_small_tables<tablez::dense::StaticTable<ROWS, int>>(state);
+}
+
+BENCHMARK(BM_DenseSmallTablesSum)->RangeMultiplier(16)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_DenseStaticTablesSum)->RangeMultiplier(16)->Range(1 << 4, 1 << 16);
+
+}  // namespace
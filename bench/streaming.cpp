@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/streaming.h>
+
+#include <atomic>
+#include <thread>
+
+// ingest through StreamingTable by batch size against plain CowTable, and reads of latest snapshot while
+//   a writer keeps ingesting
+
+namespace {
+
+constexpr uint32_t ROWS = 1 << 16;
+
+void BM_CowTableIngest(benchmark::State &state) {
+    for (auto _ : state) {
+        tablez::dense::CowTable<int, double> table;
+        for (uint32_t i = 0; i < ROWS; ++i) {
+            table.insert(static_cast<int>(i), i * 0.5);
+        }
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+void BM_StreamingIngest(benchmark::State &state) {
+    for (auto _ : state) {
+        tablez::dense::StreamingTable<int, double> table({.batch_rows = static_cast<uint32_t>(state.range(0))});
+        for (uint32_t i = 0; i < ROWS; ++i) {
+            table.insert(static_cast<int>(i), i * 0.5);
+        }
+        benchmark::DoNotOptimize(table.latest());
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+// lookup in the latest snapshot, taken for every lookup, with a writer ingesting in background
+void BM_StreamingReadUnderIngest(benchmark::State &state) {
+    tablez::dense::StreamingTable<int, double> table({.batch_rows = 1024});
+    tablez::Id id = table.insert(0, 0.0);
+    for (uint32_t i = 1; i < ROWS; ++i) {
+        table.insert(static_cast<int>(i), i * 0.5);
+    }
+    table.publish();
+    std::atomic<bool> done = false;
+    std::thread writer{[&] {
+        int i = 0;
+        while (!done) {
+            auto inserted = table.insert(i++, 0.5);
+            table.remove(inserted);
+        }
+    }};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.latest()->try_get<int>(id));
+    }
+    done = true;
+    writer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CowTableIngest);
+BENCHMARK(BM_StreamingIngest)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK(BM_StreamingReadUnderIngest);
+
+}  // namespace
@@ -0,0 +1,288 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/table.h>
+#include <tablez/sparse/table.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "common.h"
+
+// workloads run against dense and sparse tables and against baselines: std::unordered_map<Id, row> for
+//   everything keyed by Id, std::vector of structs for scans and growth
+
+namespace {
+
+using bench::PerfCounters;
+using bench::RNG;
+using bench::Row;
+
+// std::unordered_map<Id, row> with table API used below, Ids are made up from a counter
+template <class... Ts>
+class MapTable {
+public:
+    template <class... Us>
+    tablez::Id insert(Us &&...args) {
+        tablez::Id id{2, next_++};
+        rows_.emplace(id, std::tuple<Ts...>{std::forward<Us>(args)...});
+        return id;
+    }
+
+    bool remove(tablez::Id id) { return rows_.erase(id) != 0; }
+
+    template <class T>
+    const T *try_get(tablez::Id id) const {
+        auto it = rows_.find(id);
+        return it == rows_.end() ? nullptr : &std::get<T>(it->second);
+    }
+
+    template <class Func>
+    void for_each_row(Func &&func) {
+        for (auto &[id, row] : rows_) {
+            std::apply([&](Ts &...values) { func(id, values...); }, row);
+        }
+    }
+
+    uint32_t count() const { return rows_.size(); }
+
+private:
+    std::unordered_map<tablez::Id, std::tuple<Ts...>, bench::IdHash> rows_;
+    uint32_t next_ = 0;
+};
+
+template <class Table>
+std::vector<tablez::Id> fill(Table &table, size_t size) {
+    std::vector<tablez::Id> ids;
+    ids.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        ids.push_back(table.insert(static_cast<int>(i), i * 0.5));
+    }
+    return ids;
+}
+
+// remove of a random row followed by insert, with table kept at range(0) percent of CHURN_ROWS capacity
+constexpr uint32_t CHURN_ROWS = 1 << 16;
+constexpr uint32_t CHURN_OPS = 1024;
+
+template <class Table>
+void churn(benchmark::State &state) {
+    Table table;
+    auto ids = fill(table, CHURN_ROWS);
+    std::shuffle(ids.begin(), ids.end(), RNG());
+    for (size_t i = CHURN_ROWS * state.range(0) / 100; i < ids.size(); ++i) {
+        table.remove(ids[i]);
+    }
+    ids.resize(CHURN_ROWS * state.range(0) / 100);
+    std::uniform_int_distribution<size_t> pick{0, ids.size() - 1};
+    std::vector<size_t> picks(CHURN_OPS);
+    std::generate(picks.begin(), picks.end(), [&] { return pick(RNG()); });
+
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        for (size_t at : picks) {
+            table.remove(ids[at]);
+            ids[at] = table.insert(static_cast<int>(at), 0.5);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * CHURN_OPS * 2);
+    state.SetBytesProcessed(state.iterations() * CHURN_OPS * (sizeof(int) + sizeof(double)));
+}
+
+template <class Table>
+void lookup(benchmark::State &state, bool random) {
+    Table table;
+    auto ids = fill(table, state.range(0));
+    if (random) {
+        std::shuffle(ids.begin(), ids.end(), RNG());
+    }
+    const Table &view = table;
+
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto id : ids) {
+            if (auto *value = view.template try_get<int>(id)) {
+                sum += *value;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+    state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(int));
+}
+
+template <class Table>
+void scan_columns(benchmark::State &state) {
+    Table table;
+    for (auto &[i, b, d, s] : bench::generate_data(RNG(), state.range(0))) {
+        table.insert(i, b, d, std::move(s));
+    }
+
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        double sum = 0;
+        table.for_each_row([&](tablez::Id, int &i, bool &b, double &d, std::string &s) {
+            sum += b ? i * d : s.size();
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            (sizeof(int) + sizeof(bool) + sizeof(double) + sizeof(std::string)));
+}
+
+// rows of a long string get copied into a table of reserved capacity
+template <class Table>
+void insert_strings(benchmark::State &state) {
+    std::vector<std::string> strings;
+    int64_t bytes = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        auto &text = strings.emplace_back(bench::random_string(RNG()) + bench::random_string(RNG()));
+        bytes += text.size();
+    }
+
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        auto table = Table::with_capacity(strings.size());
+        for (size_t i = 0; i < strings.size(); ++i) {
+            table.insert(static_cast<int>(i), strings[i]);
+        }
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * strings.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// inserts into a fresh table without reservation, thus pays for every growth
+template <class Table>
+void grow(benchmark::State &state) {
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        Table table;
+        fill(table, state.range(0));
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (sizeof(int) + sizeof(double)));
+}
+
+// removes every row in random order
+template <class Table>
+void remove_all(benchmark::State &state) {
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Table table;
+        auto ids = fill(table, state.range(0));
+        std::shuffle(ids.begin(), ids.end(), RNG());
+        state.ResumeTiming();
+        for (auto id : ids) {
+            table.remove(id);
+        }
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using Dense = tablez::dense::Table<int, double>;
+using Sparse = tablez::sparse::Table<int, double>;
+using Map = MapTable<int, double>;
+
+void BM_DenseChurn(benchmark::State &state) { churn<Dense>(state); }
+void BM_SparseChurn(benchmark::State &state) { churn<Sparse>(state); }
+void BM_MapChurn(benchmark::State &state) { churn<Map>(state); }
+
+void BM_DenseLookupRandom(benchmark::State &state) { lookup<Dense>(state, true); }
+void BM_DenseLookupSequential(benchmark::State &state) { lookup<Dense>(state, false); }
+void BM_SparseLookupRandom(benchmark::State &state) { lookup<Sparse>(state, true); }
+void BM_SparseLookupSequential(benchmark::State &state) { lookup<Sparse>(state, false); }
+void BM_MapLookupRandom(benchmark::State &state) { lookup<Map>(state, true); }
+void BM_MapLookupSequential(benchmark::State &state) { lookup<Map>(state, false); }
+
+void BM_DenseScanColumns(benchmark::State &state) {
+    scan_columns<tablez::dense::Table<int, bool, double, std::string>>(state);
+}
+void BM_SparseScanColumns(benchmark::State &state) {
+    scan_columns<tablez::sparse::Table<int, bool, double, std::string>>(state);
+}
+void BM_MapScanColumns(benchmark::State &state) { scan_columns<MapTable<int, bool, double, std::string>>(state); }
+
+void BM_VecScanColumns(benchmark::State &state) {
+    std::vector<Row> rows;
+    for (auto &[i, b, d, s] : bench::generate_data(RNG(), state.range(0))) {
+        rows.push_back({i, b, d, std::move(s)});
+    }
+
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        double sum = 0;
+        for (auto &row : rows) {
+            sum += row.b ? row.i * row.d : row.s.size();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Row));
+}
+
+void BM_DenseInsertStrings(benchmark::State &state) {
+    insert_strings<tablez::dense::Table<int, std::string>>(state);
+}
+void BM_SparseInsertStrings(benchmark::State &state) {
+    insert_strings<tablez::sparse::Table<int, std::string>>(state);
+}
+
+void BM_DenseGrow(benchmark::State &state) { grow<Dense>(state); }
+void BM_SparseGrow(benchmark::State &state) { grow<Sparse>(state); }
+void BM_MapGrow(benchmark::State &state) { grow<Map>(state); }
+
+void BM_VecGrow(benchmark::State &state) {
+    PerfCounters perf{state};
+    for (auto _ : state) {
+        std::vector<std::pair<int, double>> vec;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            vec.emplace_back(static_cast<int>(i), i * 0.5);
+        }
+        benchmark::DoNotOptimize(vec);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (sizeof(int) + sizeof(double)));
+}
+
+void BM_DenseRemoveAll(benchmark::State &state) { remove_all<Dense>(state); }
+void BM_SparseRemoveAll(benchmark::State &state) { remove_all<Sparse>(state); }
+void BM_MapRemoveAll(benchmark::State &state) { remove_all<Map>(state); }
+
+// occupancy percent
+BENCHMARK(BM_DenseChurn)->Arg(25)->Arg(50)->Arg(90);
+BENCHMARK(BM_SparseChurn)->Arg(25)->Arg(50)->Arg(90);
+BENCHMARK(BM_MapChurn)->Arg(25)->Arg(50)->Arg(90);
+
+BENCHMARK(BM_DenseLookupRandom)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_DenseLookupSequential)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_SparseLookupRandom)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_SparseLookupSequential)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_MapLookupRandom)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_MapLookupSequential)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+BENCHMARK(BM_DenseScanColumns)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_SparseScanColumns)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_MapScanColumns)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_VecScanColumns)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+BENCHMARK(BM_DenseInsertStrings)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_SparseInsertStrings)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+BENCHMARK(BM_DenseGrow)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_SparseGrow)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_MapGrow)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_VecGrow)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+BENCHMARK(BM_DenseRemoveAll)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_SparseRemoveAll)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_MapRemoveAll)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+}  // namespace
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <tablez/dense/table.h>
+#include <tablez/top_k.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+tablez::dense::Table<double> make_table(size_t size) {
+    tablez::dense::Table<double> table;
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    for (size_t i = 0; i < size; ++i) {
+        table.insert(dist(rng));
+    }
+    return table;
+}
+
+void BM_DenseTopK(benchmark::State &state) {
+    auto table = make_table(state.range(0));
+
+    for (auto _ : state) {
+        auto top = tablez::top_k<double>(table, 100);
+        benchmark::DoNotOptimize(top);
+    }
+    state.SetItemsProcessed(state.iterations() * table.count());
+}
+
+void BM_DensePartialSort(benchmark::State &state) {
+    auto table = make_table(state.range(0));
+
+    for (auto _ : state) {
+        auto values = table.values<double>();
+        std::vector<double> copy{values.begin(), values.end()};
+        std::partial_sort(copy.begin(), copy.begin() + 100, copy.end(), std::greater<>{});
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations() * table.count());
+}
+
+BENCHMARK(BM_DenseTopK)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_DensePartialSort)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+}  // namespace
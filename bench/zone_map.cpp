@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+#include <tablez/query.h>
+
+#include <cstdint>
+
+#include "common.h"
+
+// range filter over 1M rows of a time-like column in append order, selecting range(0) rows:
+//   with zone maps against a full scan
+
+namespace {
+
+using Table = tablez::dense::Table<int64_t, double>;
+
+Table fill(bool zones) {
+    Table table;
+    if (zones) {
+        table.track_zones<int64_t>();
+    }
+    std::uniform_int_distribution<int64_t> step{1, 10};
+    int64_t time = 0;
+    for (uint32_t i = 0; i < (1 << 20); ++i) {
+        time += step(bench::RNG());
+        table.insert(time, i * 0.5);
+    }
+    return table;
+}
+
+void range_sum(benchmark::State &state, bool zones) {
+    auto table = fill(zones);
+    auto times = table.values<int64_t>();
+    int64_t from = times[times.size() / 2];
+    int64_t to = times[times.size() / 2 + state.range(0)];
+    for (auto _ : state) {
+        auto sum = tablez::from(table)
+                       .template where<int64_t>(tablez::_ >= from && tablez::_ < to)
+                       .template select<double>()
+                       .sum();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * table.count());
+}
+
+void BM_ZoneMapRangeSum(benchmark::State &state) { range_sum(state, true); }
+
+void BM_FullScanRangeSum(benchmark::State &state) { range_sum(state, false); }
+
+BENCHMARK(BM_ZoneMapRangeSum)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_FullScanRangeSum)->Arg(1000)->Arg(100000);
+
+}  // namespace
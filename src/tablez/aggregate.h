@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace tablez {
+
+template <class T>
+concept Aggregatable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+// count, sum, min and max of a column, kept up to date by table on every insert and remove.
+//   Removing current min or max, or writing through a reference makes it stale, table recomputes it on read
+template <class T>
+class Aggregate {
+public:
+    bool enabled() const noexcept { return false; }
+    // take anything, so that columns may pass references of other types, e.g. T of Optional<T>
+    template <class U>
+    void add(const U &) noexcept {}
+    template <class U>
+    void remove(const U &) noexcept {}
+    void invalidate() noexcept {}
+};
+
+template <Aggregatable T>
+class Aggregate<T> {
+public:
+    using Sum = std::conditional_t<std::is_floating_point_v<T>, double,
+                                   std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+    bool enabled() const noexcept { return enabled_; }
+
+    bool stale() const noexcept { return stale_; }
+
+    void enable() noexcept {
+        enabled_ = true;
+        stale_ = true;
+    }
+
+    void disable() noexcept { *this = Aggregate{}; }
+
+    void add(const T &value) noexcept {
+        if (!enabled_ || stale_) {
+            return;
+        }
+        min_ = count_ == 0 ? value : std::min(min_, value);
+        max_ = count_ == 0 ? value : std::max(max_, value);
+        ++count_;
+        sum_ += value;
+    }
+
+    void remove(const T &value) noexcept {
+        if (!enabled_ || stale_) {
+            return;
+        }
+        --count_;
+        sum_ -= value;
+        // extremum can't be restored without a scan
+        stale_ = count_ != 0 && (value == min_ || value == max_);
+    }
+
+    void invalidate() noexcept { stale_ = enabled_; }
+
+    template <class ForEach>
+    void recompute(ForEach &&for_each_value) {
+        *this = Aggregate{};
+        enabled_ = true;
+        for_each_value([this](const T &value) { add(value); });
+    }
+
+    uint64_t count() const noexcept { return count_; }
+
+    Sum sum() const noexcept { return sum_; }
+
+    std::optional<T> min() const noexcept { return count_ == 0 ? std::nullopt : std::optional<T>{min_}; }
+
+    std::optional<T> max() const noexcept { return count_ == 0 ? std::nullopt : std::optional<T>{max_}; }
+
+private:
+    uint64_t count_ = 0;
+    Sum sum_ = 0;
+    T min_ = 0;
+    T max_ = 0;
+    bool enabled_ = false;
+    bool stale_ = false;
+};
+}  // namespace tablez
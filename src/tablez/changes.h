@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace tablez {
+
+// remembers table version of the last change for every chunk of CHUNK_SIZE rows of a column
+class ChangeTracker {
+public:
+    static constexpr uint32_t CHUNK_SHIFT = 6;
+    static constexpr uint32_t CHUNK_SIZE = uint32_t{1} << CHUNK_SHIFT;
+
+    bool enabled() const noexcept { return enabled_; }
+
+    void enable(uint32_t capacity) {
+        versions_.assign(chunks_for(capacity), 0);
+        enabled_ = true;
+    }
+
+    void disable() noexcept {
+        versions_ = {};
+        enabled_ = false;
+    }
+
+    void reserve_at_least(uint32_t capacity) {
+        if (enabled_ && chunks_for(capacity) > versions_.size()) {
+            versions_.resize(chunks_for(capacity), 0);
+        }
+    }
+
+    void mark(uint32_t row, uint64_t version) noexcept {
+        if (enabled_) {
+            assert((row >> CHUNK_SHIFT) < versions_.size());
+            versions_[row >> CHUNK_SHIFT] = version;
+        }
+    }
+
+    void mark_all(uint32_t end, uint64_t version) noexcept {
+        if (enabled_) {
+            std::fill_n(versions_.begin(), chunks_for(end), version);
+        }
+    }
+
+    // calls func(begin, end) for runs of rows below end changed after since,
+    //   untracked column reports all of its rows
+    template <class Func>
+    void for_each_changed(uint64_t since, uint32_t end, Func &&func) const {
+        if (!enabled_) {
+            if (end != 0) {
+                func(uint32_t{0}, end);
+            }
+            return;
+        }
+        uint32_t chunks = chunks_for(end);
+        for (uint32_t chunk = 0; chunk < chunks; ++chunk) {
+            if (versions_[chunk] <= since) {
+                continue;
+            }
+            uint32_t begin = chunk << CHUNK_SHIFT;
+            while (chunk + 1 < chunks && versions_[chunk + 1] > since) {
+                ++chunk;
+            }
+            func(begin, std::min<uint32_t>(end, (uint64_t{chunk} + 1) << CHUNK_SHIFT));
+        }
+    }
+
+private:
+    static uint32_t chunks_for(uint32_t rows) noexcept {
+        return (uint64_t{rows} + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    }
+
+private:
+    std::vector<uint64_t> versions_;
+    bool enabled_ = false;
+};
+}  // namespace tablez
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <tablez/id.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tablez {
+
+namespace dense {
+template <class Policy, class... Ts>
+class BasicTable;
+}  // namespace dense
+
+namespace sparse {
+template <class Policy, class... Ts>
+class BasicTable;
+}  // namespace sparse
+
+namespace hybrid {
+template <class... Ts>
+class Table;
+}  // namespace hybrid
+
+namespace detail {
+template <class Table>
+struct CommandsOf;
+
+template <class Policy, class... Ts>
+struct CommandsOf<dense::BasicTable<Policy, Ts...>> {
+    using Id = BasicId<Policy>;
+    using Row = std::tuple<Ts...>;
+};
+
+template <class Policy, class... Ts>
+struct CommandsOf<sparse::BasicTable<Policy, Ts...>> {
+    using Id = BasicId<Policy>;
+    using Row = std::tuple<Ts...>;
+};
+
+template <class... Ts>
+struct CommandsOf<hybrid::Table<Ts...>> {
+    using Id = tablez::Id;
+    using Row = std::tuple<Ts...>;
+};
+}  // namespace detail
+
+// records inserts and removes to apply them later in one batch, e.g. ones made while iterating the table.
+//   Each shard is meant for a single thread, shards sit on separate cache lines. Recording into different
+//   shards from different threads is safe, flush() must not run concurrently with recording
+template <class Table>
+class CommandBuffer {
+    using Id = typename detail::CommandsOf<Table>::Id;
+    using Row = typename detail::CommandsOf<Table>::Row;
+
+public:
+    class alignas(64) Shard {
+        friend class CommandBuffer;
+
+    public:
+        template <class... Us>
+            requires(std::is_constructible_v<Row, Us &&...>)
+        void insert(Us &&...args) {
+            inserts_.emplace_back(std::forward<Us>(args)...);
+        }
+
+        void remove(Id id) { removes_.push_back(id); }
+
+        bool empty() const noexcept { return inserts_.empty() && removes_.empty(); }
+
+    private:
+        std::vector<Row> inserts_;
+        std::vector<Id> removes_;
+    };
+
+    explicit CommandBuffer(uint32_t shards = 1) : shards_(shards) { assert(shards > 0); }
+
+    uint32_t shard_count() const noexcept { return shards_.size(); }
+
+    Shard &shard(uint32_t idx) noexcept {
+        assert(idx < shards_.size());
+        return shards_[idx];
+    }
+
+    template <class... Us>
+        requires(std::is_constructible_v<Row, Us &&...>)
+    void insert(Us &&...args) {
+        shards_[0].insert(std::forward<Us>(args)...);
+    }
+
+    void remove(Id id) { shards_[0].remove(id); }
+
+    bool empty() const noexcept {
+        return std::all_of(shards_.begin(), shards_.end(), [](const Shard &shard) { return shard.empty(); });
+    }
+
+    // applies removes of all shards first, without repeats, then inserts with one reservation for all of them.
+    //   Returns Ids of inserted rows, shard by shard in order of recording
+    std::vector<Id> flush(Table &table) {
+        std::vector<Id> removes;
+        size_t insert_count = 0;
+        for (auto &shard : shards_) {
+            removes.insert(removes.end(), shard.removes_.begin(), shard.removes_.end());
+            insert_count += shard.inserts_.size();
+            shard.removes_.clear();
+        }
+        if constexpr (requires { table.remove_many(std::span<const Id>{removes}); }) {
+            if (!removes.empty()) {
+                table.remove_many(removes);  // sorts by row and drops repeats itself
+            }
+        } else if (!removes.empty()) {
+            std::sort(removes.begin(), removes.end(),
+                      [](Id lhs, Id rhs) { return std::pair(lhs.idx(), lhs.gen()) < std::pair(rhs.idx(), rhs.gen()); });
+            removes.erase(std::unique(removes.begin(), removes.end()), removes.end());
+            for (Id id : removes) {
+                table.remove(id);
+            }
+        }
+
+        std::vector<Id> inserted;
+        inserted.reserve(insert_count);
+        if constexpr (requires { table.reserve_at_least(uint32_t{}); }) {
+            table.reserve_at_least(table.count() + insert_count);
+        }
+        for (auto &shard : shards_) {
+            for (auto &values : shard.inserts_) {
+                inserted.push_back(
+                    std::apply([&](auto &...value) { return table.insert(std::move(value)...); }, values));
+            }
+            shard.inserts_.clear();
+        }
+        return inserted;
+    }
+
+private:
+    std::vector<Shard> shards_;
+};
+}  // namespace tablez
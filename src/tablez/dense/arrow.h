@@ -0,0 +1,323 @@
+#pragma once
+
+#include <tablez/id.h>
+#include <tablez/util.h>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "table.h"
+
+// ABI structs of Arrow C data interface, see https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *);
+    void *private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *);
+    void *private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace tablez::dense {
+
+// trivially copyable columns are shared as is, bool gets packed into bitmap and strings into utf8 layout
+template <class T>
+concept ArrowExportable = std::is_same_v<T, std::string> || std::is_trivially_copyable_v<T>;
+
+namespace detail {
+
+template <class T>
+std::string arrow_format() {
+    if constexpr (std::is_same_v<T, bool>) {
+        return "b";
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return "u";
+    } else if constexpr (std::is_same_v<T, float>) {
+        return "f";
+    } else if constexpr (std::is_same_v<T, double>) {
+        return "g";
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) <= 8) {
+        constexpr std::string_view FORMATS = "cCsSiIlL";  // signed and unsigned per 1, 2, 4 and 8 bytes
+        return std::string(1, FORMATS[2 * std::countr_zero(sizeof(T)) + std::is_unsigned_v<T>]);
+    } else {
+        return "w:" + std::to_string(sizeof(T));  // fixed size binary
+    }
+}
+
+// private data of every exported struct, children own theirs, so they may be moved out and released on their
+//   own. Ones which weren't moved out yet get released along with their parent's data
+struct ArrowSchemaData {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema *> child_ptrs;
+
+    ArrowSchemaData() = default;
+    ArrowSchemaData(const ArrowSchemaData &) = delete;
+    ArrowSchemaData &operator=(const ArrowSchemaData &) = delete;
+
+    ~ArrowSchemaData() noexcept {
+        for (auto &child : children) {
+            if (child.release) {
+                child.release(&child);
+            }
+        }
+    }
+};
+
+struct ArrowArrayData {
+    std::shared_ptr<const void> pin;  // keeps exported table alive
+    std::vector<const void *> buffers;
+    std::vector<uint8_t> bitmap;
+    std::vector<int32_t> offsets;
+    std::vector<int64_t> large_offsets;  // instead of offsets once chars don't fit int32
+    std::string chars;
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray *> child_ptrs;
+
+    ArrowArrayData() = default;
+    ArrowArrayData(const ArrowArrayData &) = delete;
+    ArrowArrayData &operator=(const ArrowArrayData &) = delete;
+
+    ~ArrowArrayData() noexcept {
+        for (auto &child : children) {
+            if (child.release) {
+                child.release(&child);
+            }
+        }
+    }
+};
+
+template <class Arrow, class Data>
+void release(Arrow *arrow) {
+    delete static_cast<Data *>(arrow->private_data);
+    arrow->release = nullptr;
+}
+
+inline ArrowSchema make_schema(ArrowSchemaData *data) {
+    return ArrowSchema{
+        .format = data->format.c_str(),
+        .name = data->name.c_str(),
+        .metadata = nullptr,
+        .flags = 0,
+        .n_children = int64_t(data->child_ptrs.size()),
+        .children = data->child_ptrs.empty() ? nullptr : data->child_ptrs.data(),
+        .dictionary = nullptr,
+        .release = release<ArrowSchema, ArrowSchemaData>,
+        .private_data = data,
+    };
+}
+
+inline ArrowArray make_array(ArrowArrayData *data, int64_t length) {
+    return ArrowArray{
+        .length = length,
+        .null_count = 0,
+        .offset = 0,
+        .n_buffers = int64_t(data->buffers.size()),
+        .n_children = int64_t(data->child_ptrs.size()),
+        .buffers = data->buffers.data(),
+        .children = data->child_ptrs.empty() ? nullptr : data->child_ptrs.data(),
+        .dictionary = nullptr,
+        .release = release<ArrowArray, ArrowArrayData>,
+        .private_data = data,
+    };
+}
+
+template <class Offset>
+void export_strings(std::span<const std::string> values, std::vector<Offset> &offsets, std::string &chars) {
+    offsets.reserve(values.size() + 1);
+    offsets.push_back(0);
+    for (auto &value : values) {
+        chars += value;
+        offsets.push_back(chars.size());
+    }
+}
+
+// fills buffers of data, format is changed for strings which need large utf8 layout, i.e. int64 offsets
+template <class T>
+void export_buffers(std::span<const T> values, ArrowArrayData &data, std::string &format) {
+    auto &buffers = data.buffers;
+    buffers.push_back(nullptr);  // validity, no nulls
+    if constexpr (std::is_same_v<T, bool>) {
+        auto &bits = data.bitmap;
+        bits.assign((values.size() + 7) / 8, 0);
+        for (size_t i = 0; i < values.size(); ++i) {
+            bits[i / 8] |= uint8_t{values[i]} << (i % 8);
+        }
+        buffers.push_back(bits.data());
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        uint64_t size = 0;
+        for (auto &value : values) {
+            size += value.size();
+        }
+        data.chars.reserve(size);
+        if (size <= uint64_t{std::numeric_limits<int32_t>::max()}) {
+            export_strings(values, data.offsets, data.chars);
+            buffers.push_back(data.offsets.data());
+        } else {
+            format = "U";
+            export_strings(values, data.large_offsets, data.chars);
+            buffers.push_back(data.large_offsets.data());
+        }
+        buffers.push_back(data.chars.data());
+    } else {
+        buffers.push_back(values.data());  // zero copy
+    }
+}
+
+inline bool has_nulls(const ArrowArray &array) {
+    return array.null_count > 0 || (array.null_count < 0 && array.buffers[0]);
+}
+
+// struct's offset applies to its children too, thus child must cover [0, parent.offset + parent.length)
+inline bool covers(const ArrowArray &child, const ArrowArray &parent) {
+    return child.offset >= 0 && child.length >= parent.offset + parent.length;
+}
+
+// strings may come in large utf8 layout too
+inline bool is_large_utf8(const ArrowSchema &schema) { return std::string_view(schema.format) == "U"; }
+
+template <class T>
+bool can_import(const ArrowSchema &schema, const ArrowArray &array, const ArrowArray &parent) {
+    bool format = arrow_format<T>() == schema.format || (std::is_same_v<T, std::string> && is_large_utf8(schema));
+    return format && array.n_buffers == (std::is_same_v<T, std::string> ? 3 : 2) && !has_nulls(array) &&
+           covers(array, parent);
+}
+
+template <class T>
+T import_value(const ArrowSchema &schema, const ArrowArray &array, int64_t row) {
+    row += array.offset;
+    if constexpr (std::is_same_v<T, bool>) {
+        return (static_cast<const uint8_t *>(array.buffers[1])[row / 8] >> (row % 8)) & 1;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        auto *chars = static_cast<const char *>(array.buffers[2]);
+        if (is_large_utf8(schema)) {
+            auto *offsets = static_cast<const int64_t *>(array.buffers[1]);
+            return std::string(chars + offsets[row], chars + offsets[row + 1]);
+        }
+        auto *offsets = static_cast<const int32_t *>(array.buffers[1]);
+        return std::string(chars + offsets[row], chars + offsets[row + 1]);
+    } else {
+        T value;
+        std::memcpy(&value, static_cast<const uint8_t *>(array.buffers[1]) + row * sizeof(T), sizeof(T));
+        return value;
+    }
+}
+}  // namespace detail
+
+// exports table as Arrow struct array: Ids as uint64 "id" column, followed by columns named after names,
+//   or their index. Buffers of trivially copyable columns and of Ids point right into table, which is pinned
+//   until array gets released. Table must not be changed in the meantime. Strings which don't fit int32
+//   offsets get exported as large utf8. schema and array are written only once the export can't fail
+template <ArrowExportable... Ts>
+void export_arrow(std::shared_ptr<const Table<Ts...>> table, ArrowSchema *schema, ArrowArray *array,
+                  std::span<const std::string> names = {}) {
+    constexpr size_t N = sizeof...(Ts) + 1;
+    assert(names.empty() || names.size() == sizeof...(Ts));
+
+    std::vector<std::string> formats{"L", detail::arrow_format<Ts>()...};
+    std::shared_ptr<const void> pin = table;
+    auto array_data = std::make_unique<detail::ArrowArrayData>();
+    array_data->buffers.push_back(nullptr);
+    array_data->children.reserve(N);
+    array_data->child_ptrs.reserve(N);
+    std::vector<std::unique_ptr<detail::ArrowArrayData>> column_data(N);
+    for (auto &data : column_data) {
+        data = std::make_unique<detail::ArrowArrayData>();
+        data->pin = pin;
+    }
+    column_data[0]->buffers = {nullptr, table->ids().data()};
+    size_t column = 1;
+    (..., (detail::export_buffers(table->template values<Ts>(), *column_data[column], formats[column]), ++column));
+    for (auto &data : column_data) {
+        array_data->children.push_back(detail::make_array(data.release(), table->count()));
+        array_data->child_ptrs.push_back(&array_data->children.back());
+    }
+
+    auto schema_data = std::make_unique<detail::ArrowSchemaData>();
+    schema_data->format = "+s";
+    schema_data->children.reserve(N);
+    schema_data->child_ptrs.reserve(N);
+    for (size_t i = 0; i < N; ++i) {
+        auto child_data = std::make_unique<detail::ArrowSchemaData>();
+        child_data->format = std::move(formats[i]);
+        if (i == 0) {
+            child_data->name = "id";
+        } else {
+            child_data->name = names.empty() ? std::to_string(i - 1) : names[i - 1];
+        }
+        schema_data->children.push_back(detail::make_schema(child_data.release()));
+        schema_data->child_ptrs.push_back(&schema_data->children.back());
+    }
+
+    *schema = detail::make_schema(schema_data.release());
+    *array = detail::make_array(array_data.release(), table->count());
+}
+
+// same for a table which isn't const, so that Ts get deduced
+template <ArrowExportable... Ts>
+void export_arrow(std::shared_ptr<Table<Ts...>> table, ArrowSchema *schema, ArrowArray *array,
+                  std::span<const std::string> names = {}) {
+    export_arrow(std::shared_ptr<const Table<Ts...>>(std::move(table)), schema, array, names);
+}
+
+// copies Arrow struct array into a new table, its children are columns in order of Ts. An extra first child
+//   is taken as exported Ids and skipped, rows get new Ids. Fails on mismatched types and on nulls.
+//   Doesn't take ownership of schema and array, caller releases them
+template <ArrowExportable... Ts>
+std::optional<Table<Ts...>> import_arrow(const ArrowSchema &schema, const ArrowArray &array) {
+    constexpr int64_t N = sizeof...(Ts);
+    if (std::string_view(schema.format) != "+s" || schema.n_children != array.n_children || detail::has_nulls(array) ||
+        (array.n_children != N && array.n_children != N + 1) || array.offset < 0 || array.length < 0) {
+        return std::nullopt;
+    }
+    int64_t first = array.n_children - N;
+    return [&]<size_t... Is>(std::index_sequence<Is...>) -> std::optional<Table<Ts...>> {
+        if (!(... && detail::can_import<Ts>(*schema.children[first + Is], *array.children[first + Is], array))) {
+            return std::nullopt;
+        }
+
+        auto table = Table<Ts...>::with_capacity(array.length);
+        for (int64_t row = array.offset; row < array.offset + array.length; ++row) {
+            table.insert(detail::import_value<Ts>(*schema.children[first + Is], *array.children[first + Is], row)...);
+        }
+        return table;
+    }(std::index_sequence_for<Ts...>{});
+}
+}  // namespace tablez::dense
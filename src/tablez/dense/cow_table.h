@@ -0,0 +1,346 @@
+#pragma once
+
+#include <tablez/id.h>
+#include <tablez/util.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tablez::dense {
+
+constexpr uint32_t COW_CHUNK_SHIFT = 10;
+constexpr uint32_t COW_CHUNK_SIZE = uint32_t{1} << COW_CHUNK_SHIFT;
+
+// fixed-capacity storage with constructed prefix of size() elements
+template <class T>
+class CowChunk {
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    CowChunk() noexcept = default;
+
+    CowChunk(const CowChunk &rhs) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        for (; size_ < rhs.size_; ++size_) {
+            new (data_ + size_) T(rhs.at(size_));
+        }
+    }
+
+    CowChunk &operator=(const CowChunk &) = delete;
+
+    ~CowChunk() noexcept {
+        while (size_ != 0) {
+            pop();
+        }
+    }
+
+    uint32_t size() const noexcept { return size_; }
+
+    T &at(uint32_t idx) noexcept {
+        assert(idx < size_);
+        return reinterpret_cast<T &>(data_[idx]);
+    }
+
+    const T &at(uint32_t idx) const noexcept {
+        assert(idx < size_);
+        return reinterpret_cast<const T &>(data_[idx]);
+    }
+
+    std::span<const T> span() const noexcept { return {reinterpret_cast<const T *>(data_), size_}; }
+
+    template <class... Args>
+    void push(Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>) {
+        assert(size_ < COW_CHUNK_SIZE);
+        new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    void pop() noexcept {
+        assert(size_ > 0);
+        reinterpret_cast<T &>(data_[--size_]).~T();
+    }
+
+private:
+    Storage data_[COW_CHUNK_SIZE];
+    uint32_t size_ = 0;
+};
+
+// owning pointer to a chunk shared between copies of CowVector. Unlike shared_ptr::use_count(), shared()
+//   loads the count with acquire, thus once it's false, reads of the copies which let go of the chunk,
+//   e.g. on other threads, happen before the owner's writes into it
+template <class T>
+class ChunkPtr {
+    struct Counted {
+        std::atomic<uint32_t> refs = 1;
+        CowChunk<T> chunk;
+
+        Counted() noexcept = default;
+        explicit Counted(const CowChunk<T> &rhs) : chunk{rhs} {}
+    };
+
+public:
+    template <class... Args>
+    static ChunkPtr make(Args &&...args) {
+        return ChunkPtr{new Counted(std::forward<Args>(args)...)};
+    }
+
+    ChunkPtr(const ChunkPtr &rhs) noexcept : counted_{rhs.counted_} {
+        counted_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ChunkPtr(ChunkPtr &&rhs) noexcept : counted_{std::exchange(rhs.counted_, nullptr)} {}
+
+    ChunkPtr &operator=(ChunkPtr rhs) noexcept {
+        std::swap(counted_, rhs.counted_);
+        return *this;
+    }
+
+    ~ChunkPtr() noexcept {
+        if (counted_ != nullptr && counted_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete counted_;
+        }
+    }
+
+    bool shared() const noexcept { return counted_->refs.load(std::memory_order_acquire) > 1; }
+
+    CowChunk<T> &operator*() const noexcept { return counted_->chunk; }
+
+    CowChunk<T> *operator->() const noexcept { return &counted_->chunk; }
+
+private:
+    explicit ChunkPtr(Counted *counted) noexcept : counted_{counted} {}
+
+private:
+    Counted *counted_;
+};
+
+// vector of chunks, which are shared between copies until one of them writes into it.
+//   Copy costs O(chunks), write into a shared chunk copies the chunk first
+template <class T>
+class CowVector {
+    using Chunk = CowChunk<T>;
+
+public:
+    uint32_t size() const noexcept { return size_; }
+
+    uint32_t chunk_count() const noexcept { return chunks_.size(); }
+
+    std::span<const T> chunk(uint32_t chunk_idx) const noexcept { return chunks_[chunk_idx]->span(); }
+
+    const T &operator[](uint32_t idx) const noexcept {
+        assert(idx < size_);
+        return chunks_[idx >> COW_CHUNK_SHIFT]->at(idx & (COW_CHUNK_SIZE - 1));
+    }
+
+    T &get_mut(uint32_t idx) {
+        assert(idx < size_);
+        return unshare(idx >> COW_CHUNK_SHIFT).at(idx & (COW_CHUNK_SIZE - 1));
+    }
+
+    template <class... Args>
+    void emplace_back(Args &&...args) {
+        if ((size_ & (COW_CHUNK_SIZE - 1)) == 0) {
+            chunks_.push_back(ChunkPtr<T>::make());
+        }
+        unshare(size_ >> COW_CHUNK_SHIFT).push(std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    void pop_back() {
+        assert(size_ > 0);
+        --size_;
+        uint32_t chunk_idx = size_ >> COW_CHUNK_SHIFT;
+        if ((size_ & (COW_CHUNK_SIZE - 1)) == 0) {
+            chunks_.pop_back();  // drop whole chunk, no need to copy it
+        } else {
+            unshare(chunk_idx).pop();
+        }
+    }
+
+    // whether pop_back() drops a whole chunk which is shared with other copies
+    bool drops_shared_chunk() const noexcept {
+        assert(size_ > 0);
+        return ((size_ - 1) & (COW_CHUNK_SIZE - 1)) == 0 && chunks_.back().shared();
+    }
+
+    // chunks shared with other copies, i.e. snapshots
+    uint32_t shared_chunks() const noexcept {
+        uint32_t shared = 0;
+        for (auto &chunk : chunks_) {
+            shared += chunk.shared();
+        }
+        return shared;
+    }
+
+private:
+    Chunk &unshare(uint32_t chunk_idx) {
+        auto &chunk = chunks_[chunk_idx];
+        // only owner can make new copies, thus unshared chunk stays that way
+        if (chunk.shared()) {
+            chunk = ChunkPtr<T>::make(*chunk);
+        }
+        return *chunk;
+    }
+
+private:
+    std::vector<ChunkPtr<T>> chunks_;
+    uint32_t size_ = 0;
+};
+
+// immutable point-in-time view of CowTable, safe to read from any thread
+template <class... Ts>
+class Snapshot {
+    template <class... Us>
+    friend class CowTable;
+
+    struct GenIdx {
+        uint32_t gen = Id::EMPTY_GEN;
+        uint32_t idx;
+    };
+
+public:
+    Snapshot() = default;
+
+    uint32_t count() const noexcept { return count_; }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    const T *try_get(Id id) const noexcept {
+        if (id.idx() >= index_.size()) {
+            return nullptr;
+        }
+        auto at = index_[id.idx()];
+        if (at.gen != id.gen()) {
+            return nullptr;
+        }
+        return &column<T>()[at.idx];
+    }
+
+    template <class T, class Func>
+        requires(IsUniqueAmong<T, Ts...> && std::is_invocable_r_v<void, Func, Id, const T &>)
+    void for_each(Func &&func) const noexcept(std::is_nothrow_invocable_v<Func, Id, const T &>) {
+        auto &col = column<T>();
+        for (uint32_t chunk = 0; chunk < col.chunk_count(); ++chunk) {
+            auto ids = ids_.chunk(chunk);
+            auto values = col.chunk(chunk);
+            for (uint32_t i = 0; i < values.size(); ++i) {
+                func(ids[i], values[i]);
+            }
+        }
+    }
+
+protected:
+    template <class T>
+    const CowVector<T> &column() const noexcept {
+        return std::get<CowVector<T>>(columns_);
+    }
+
+protected:
+    uint32_t count_ = 0;
+    CowVector<GenIdx> index_;  // by Id::idx(), points into rows
+    CowVector<Id> ids_;        // before count_: Ids of rows, after count_: free Ids
+    std::tuple<CowVector<Ts>...> columns_;
+};
+
+// dense table over chunked copy-on-write storage: snapshot() costs O(chunks), after that writer copies
+//   only chunks it touches. Writer (or code synchronized with it) calls snapshot(), snapshots themselves
+//   may be passed to and read by other threads
+template <class... Ts>
+class CowTable : private Snapshot<Ts...> {
+    using Base = Snapshot<Ts...>;
+    using GenIdx = typename Base::GenIdx;
+
+public:
+    using Base::count;
+    using Base::for_each;
+    using Base::try_get;
+
+    uint32_t capacity() const noexcept { return this->index_.size(); }
+
+    Snapshot<Ts...> snapshot() const { return static_cast<const Base &>(*this); }
+
+    template <class... Us>
+        requires(std::is_constructible_v<Ts, Us &&> && ...)
+    Id insert(Us &&...args) {
+        if (this->count_ == capacity()) {
+            grow();
+        }
+        uint32_t row = this->count_++;
+        Id &id = this->ids_.get_mut(row);
+        id.make_gen_valid();
+        this->index_.get_mut(id.idx()) = {.gen = id.gen(), .idx = row};
+        (..., column_mut<Ts>().emplace_back(std::forward<Us>(args)));
+        return id;
+    }
+
+    bool remove(Id id) {
+        if (id.idx() >= capacity() || this->index_[id.idx()].gen != id.gen()) {
+            return false;
+        }
+        auto &at = this->index_.get_mut(id.idx());
+        uint32_t row = at.idx;
+        uint32_t last = --this->count_;
+        at.gen += Id::EMPTY_GEN;
+
+        // same swap with the last as Index does
+        Id last_id = this->ids_[last];
+        Id removed = this->ids_[row];
+        this->index_.get_mut(last_id.idx()).idx = row;
+        // row may be the last itself, so the removed Id goes in after the moved one
+        this->ids_.get_mut(row) = last_id;
+        this->ids_.get_mut(last) = removed.make_gen_invalid();
+
+        (..., remove_at<Ts>(row, last));
+        return true;
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    T *try_get(Id id) {
+        if (id.idx() >= capacity() || this->index_[id.idx()].gen != id.gen()) {
+            return nullptr;
+        }
+        return &column_mut<T>().get_mut(this->index_[id.idx()].idx);
+    }
+
+    // chunks shared with live snapshots, i.e. not yet copied by writes
+    uint32_t shared_chunks() const noexcept {
+        return this->index_.shared_chunks() + this->ids_.shared_chunks() +
+               (... + this->template column<Ts>().shared_chunks());
+    }
+
+private:
+    void grow() {
+        uint32_t begin = capacity();
+        for (uint32_t i = begin; i < begin + COW_CHUNK_SIZE; ++i) {
+            this->index_.emplace_back(GenIdx{.gen = Id::EMPTY_GEN, .idx = i});
+            this->ids_.emplace_back(Id::make_empty(i));
+        }
+    }
+
+    template <class T>
+    void remove_at(uint32_t row, uint32_t last) {
+        auto &col = column_mut<T>();
+        if (row != last) {
+            T &dst = col.get_mut(row);
+            // shared chunk which pop_back() drops doesn't get copied just to move its only value out
+            if (col.drops_shared_chunk()) {
+                dst = col[last];
+            } else {
+                dst = std::move(col.get_mut(last));
+            }
+        }
+        col.pop_back();
+    }
+
+    template <class T>
+    CowVector<T> &column_mut() noexcept {
+        return std::get<CowVector<T>>(this->columns_);
+    }
+};
+}  // namespace tablez::dense
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "table.h"
+#include "tablez/util.h"
+
+namespace tablez::dense {
+
+template <class T>
+concept CsvParsable = std::is_arithmetic_v<T> || std::is_same_v<T, std::string>;
+
+struct CsvOptions {
+    char delimiter = ',';
+    bool header = true;    // skip the first line
+    uint32_t threads = 0;  // 0 for std::thread::hardware_concurrency()
+};
+
+namespace detail {
+
+template <class T>
+bool parse_field(std::string_view field, T &out) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        out.assign(field);
+        return true;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (field == "1" || field == "true") {
+            out = true;
+        } else if (field == "0" || field == "false") {
+            out = false;
+        } else {
+            return false;
+        }
+        return true;
+    } else {
+        auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), out);
+        return ec == std::errc{} && end == field.data() + field.size();
+    }
+}
+
+// one thread's share of rows, column by column
+template <class... Ts>
+struct CsvChunk {
+    std::tuple<std::vector<Ts>...> columns;
+    bool ok = true;
+
+    template <size_t... Is>
+    bool parse_line(std::string_view line, char delimiter, std::index_sequence<Is...>) {
+        size_t pos = 0;
+        bool ok = true;
+        auto next = [&]<class T>(std::vector<T> &column) {
+            if (!ok || pos > line.size()) {
+                ok = false;
+                return;
+            }
+            size_t end = std::min(line.find(delimiter, pos), line.size());
+            T value{};
+            ok = parse_field(line.substr(pos, end - pos), value);
+            column.push_back(std::move(value));
+            pos = end + 1;
+        };
+        (..., next(std::get<Is>(columns)));
+        return ok && pos == line.size() + 1;  // no fields left
+    }
+
+    // parses lines of text, which must start at line start
+    void parse(std::string_view text, char delimiter) {
+        while (!text.empty()) {
+            size_t end = std::min(text.find('\n'), text.size());
+            auto line = text.substr(0, end);
+            text.remove_prefix(std::min(end + 1, text.size()));
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.empty()) {
+                continue;
+            }
+            if (!parse_line(line, delimiter, std::index_sequence_for<Ts...>{})) {
+                ok = false;
+                return;
+            }
+        }
+    }
+};
+}  // namespace detail
+
+// parses delimited text into a new table, row per line in order of lines. Text gets split at line breaks
+//   into a part per thread, each parses its own columns, which then get moved into the table at once.
+//   Fields can't be quoted, empty lines are skipped. Returns nullopt on a malformed line
+template <CsvParsable... Ts>
+std::optional<Table<Ts...>> parse_csv(std::string_view text, CsvOptions options = {}) {
+    if (options.header) {
+        size_t end = text.find('\n');
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+    uint32_t threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<size_t>(1, std::min<size_t>(threads, text.size() / 4096));  // not worth it for small text
+
+    std::vector<std::string_view> parts;
+    size_t begin = 0;
+    for (uint32_t i = 1; i <= threads; ++i) {
+        size_t end = text.size() * i / threads;
+        if (i != threads && end > begin) {
+            end = text.find('\n', end - 1);
+            end = end == std::string_view::npos ? text.size() : end + 1;
+        }
+        end = std::max(end, begin);
+        parts.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+
+    std::vector<detail::CsvChunk<Ts...>> chunks(threads);
+    parallel_chunks(threads, threads, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            chunks[i].parse(parts[i], options.delimiter);
+        }
+    });
+
+    size_t rows = 0;
+    for (auto &chunk : chunks) {
+        if (!chunk.ok) {
+            return std::nullopt;
+        }
+        rows += std::get<0>(chunk.columns).size();
+    }
+    auto table = Table<Ts...>::with_capacity(rows);
+    for (auto &chunk : chunks) {
+        std::apply([&](auto &...columns) { table.insert_many(columns...); }, chunk.columns);
+    }
+    return table;
+}
+
+// maps file into memory and parses it with parse_csv(), nullopt if it can't be read
+template <CsvParsable... Ts>
+std::optional<Table<Ts...>> load_csv(const char *path, CsvOptions options = {}) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return parse_csv<Ts...>({}, options);
+    }
+    void *data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return std::nullopt;
+    }
+    ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+    auto table = parse_csv<Ts...>({static_cast<const char *>(data), size_t(st.st_size)}, options);
+    ::munmap(data, st.st_size);
+    return table;
+}
+}  // namespace tablez::dense
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <tablez/id.h>
+#include <tablez/util.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "index.h"
+#include "thin_vector.h"
+
+namespace tablez::dense {
+
+// types of columns chosen at runtime, in the order of alternatives of DynamicValue
+enum class ColumnType : uint8_t { Int32, Int64, Double, Bool, String };
+
+struct ColumnSpec {
+    std::string name;
+    ColumnType type;
+};
+
+// a single value of any column type, index() is its ColumnType
+using DynamicValue = std::variant<int32_t, int64_t, double, bool, std::string>;
+
+// values of a whole column for insert_many(), index() is its ColumnType
+using DynamicSpan = std::variant<std::span<const int32_t>, std::span<const int64_t>, std::span<const double>,
+                                 std::span<const bool>, std::span<const std::string>>;
+
+enum class Compare : uint8_t { Less, LessEq, Equal, NotEqual, GreaterEq, Greater };
+
+struct ColumnAggregate {
+    uint64_t count = 0;
+    DynamicValue sum;  // int64_t for integer and bool columns, double for double ones
+    std::optional<DynamicValue> min;
+    std::optional<DynamicValue> max;
+};
+
+// Table with schema given at runtime, rows are packed the same way as in Table. Every column is a ThinVector
+//   of one of ColumnType types, operations dispatch on the type once per column and call, never per row,
+//   thus kernels get typed spans and loops the compiler can vectorize
+class DynamicTable {
+    using Column = std::variant<ThinVector<int32_t>, ThinVector<int64_t>, ThinVector<double>, ThinVector<bool>,
+                                ThinVector<std::string>>;
+
+public:
+    explicit DynamicTable(std::vector<ColumnSpec> schema) : schema_(std::move(schema)) {
+        columns_.reserve(schema_.size());
+        for (const auto &spec : schema_) {
+            columns_.push_back(make_column(spec.type));
+        }
+    }
+
+    DynamicTable(DynamicTable &&rhs) noexcept
+        : schema_(std::move(rhs.schema_)), columns_(std::move(rhs.columns_)), index_(std::exchange(rhs.index_, {})) {
+        rhs.columns_.clear();
+    }
+
+    DynamicTable &operator=(DynamicTable &&rhs) noexcept {
+        if (this == &rhs) {
+            return *this;
+        }
+        destroy();
+        schema_ = std::move(rhs.schema_);
+        columns_ = std::move(rhs.columns_);
+        index_ = std::exchange(rhs.index_, {});
+        rhs.columns_.clear();
+        return *this;
+    }
+
+    ~DynamicTable() noexcept { destroy(); }
+
+    const std::vector<ColumnSpec> &schema() const noexcept { return schema_; }
+
+    // -1 when there is no column named so
+    int32_t find_column(std::string_view name) const noexcept {
+        for (uint32_t i = 0; i < schema_.size(); ++i) {
+            if (schema_[i].name == name) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // calls taking a column fail the same way as on type mismatch when it's out of schema, e.g. -1
+    bool has_column(uint32_t column) const noexcept { return column < columns_.size(); }
+
+    // row must have a value of the matching type for every column, nullopt otherwise
+    std::optional<Id> insert(std::span<const DynamicValue> row) {
+        if (!matches(row)) {
+            return std::nullopt;
+        }
+        reserve_at_least(count() + 1);
+        uint32_t last = count();
+        for (uint32_t i = 0; i < columns_.size(); ++i) {
+            std::visit([&](auto &column) { column.insert_at(last, std::get<ValueOf<decltype(column)>>(row[i])); },
+                       columns_[i]);
+        }
+        return index_.push();
+    }
+
+    // copies values of every column in as new rows, spans must match the schema and be of the same size.
+    //   Returns Ids of new rows, valid until next insert or remove, or nullopt on mismatch
+    std::optional<std::span<const Id>> insert_many(std::span<const DynamicSpan> values) {
+        if (!matches(values)) {
+            return std::nullopt;
+        }
+        uint32_t n = values.empty() ? 0 : std::visit([](auto span) { return span.size(); }, values[0]);
+        for (const auto &span : values) {
+            if (std::visit([](auto span) { return span.size(); }, span) != n) {
+                return std::nullopt;
+            }
+        }
+        reserve_at_least(count() + n);
+        uint32_t begin = count();
+        for (uint32_t i = 0; i < columns_.size(); ++i) {
+            std::visit(
+                [&](auto &column) {
+                    column.copy_in(begin, std::get<std::span<const ValueOf<decltype(column)>>>(values[i]).data(), n);
+                },
+                columns_[i]);
+        }
+        return index_.push_many(n);
+    }
+
+    // last row gets moved into place of removed one
+    bool remove(Id id) noexcept {
+        int64_t row = index_.try_remove(id);
+        if (row < 0) {
+            return false;
+        }
+        for (auto &column : columns_) {
+            std::visit([&](auto &column) { column.remove_at(row, count()); }, column);
+        }
+        return true;
+    }
+
+    bool contains(Id id) const noexcept {
+        uint32_t row;
+        return index_.try_get_idx_checked(id, row);
+    }
+
+    // nullptr when Id isn't alive or column isn't of type T
+    template <class T>
+    T *try_get(Id id, uint32_t column) noexcept {
+        if (!has_column(column)) {
+            return nullptr;
+        }
+        auto *values = std::get_if<ThinVector<T>>(&columns_[column]);
+        uint32_t row;
+        return values != nullptr && index_.try_get_idx_checked(id, row) ? &values->get_unchecked(row) : nullptr;
+    }
+
+    template <class T>
+    const T *try_get(Id id, uint32_t column) const noexcept {
+        return const_cast<DynamicTable *>(this)->try_get<T>(id, column);
+    }
+
+    std::optional<DynamicValue> get(Id id, uint32_t column) const {
+        uint32_t row;
+        if (!has_column(column) || !index_.try_get_idx_checked(id, row)) {
+            return std::nullopt;
+        }
+        return std::visit([&](const auto &values) { return DynamicValue{values.get_unchecked(row)}; },
+                          columns_[column]);
+    }
+
+    // false when Id isn't alive or value type doesn't match the column
+    bool set(Id id, uint32_t column, DynamicValue value) {
+        uint32_t row;
+        if (!has_column(column) || value.index() != columns_[column].index() || !index_.try_get_idx_checked(id, row)) {
+            return false;
+        }
+        std::visit(
+            [&](auto &values) { values.get_unchecked(row) = std::move(std::get<ValueOf<decltype(values)>>(value)); },
+            columns_[column]);
+        return true;
+    }
+
+    // contiguous values of column in row order, row i belongs to ids()[i]. Empty if column isn't of type T.
+    //   Invalidated by any insert or remove
+    template <class T>
+    std::span<const T> values(uint32_t column) const noexcept {
+        if (!has_column(column)) {
+            return {};
+        }
+        auto *values = std::get_if<ThinVector<T>>(&columns_[column]);
+        return values == nullptr ? std::span<const T>{} : values->span(count());
+    }
+
+    std::span<const Id> ids() const noexcept { return index_.span(); }
+
+    // calls func with std::span<const T> of column values, T being the type of column. Func gets
+    //   instantiated for every column type. Column must be in schema
+    template <class Func>
+    decltype(auto) visit_column(uint32_t column, Func &&func) const {
+        assert(has_column(column));
+        return std::visit(
+            [&](const auto &values) { return func(std::span<const ValueOf<decltype(values)>>{values.span(count())}); },
+            columns_[column]);
+    }
+
+    // Ids of rows which value of column satisfies pred, in row order. Pred gets instantiated for every
+    //   column type, the loop is branchless
+    template <class Pred>
+    std::vector<Id> filter_if(uint32_t column, Pred &&pred) const {
+        if (!has_column(column)) {
+            return {};
+        }
+        return visit_column(column, [&](auto values) { return select(values, pred); });
+    }
+
+    // Ids of rows which value of column compares to operand as given, nullopt when types don't match
+    std::optional<std::vector<Id>> filter(uint32_t column, Compare cmp, const DynamicValue &operand) const {
+        if (!has_column(column) || operand.index() != columns_[column].index()) {
+            return std::nullopt;
+        }
+        return std::visit(
+            [&](const auto &rhs) {
+                auto values = this->values<std::decay_t<decltype(rhs)>>(column);
+                switch (cmp) {
+                    case Compare::Less:
+                        return select(values, [&](const auto &lhs) { return lhs < rhs; });
+                    case Compare::LessEq:
+                        return select(values, [&](const auto &lhs) { return lhs <= rhs; });
+                    case Compare::Equal:
+                        return select(values, [&](const auto &lhs) { return lhs == rhs; });
+                    case Compare::NotEqual:
+                        return select(values, [&](const auto &lhs) { return lhs != rhs; });
+                    case Compare::GreaterEq:
+                        return select(values, [&](const auto &lhs) { return lhs >= rhs; });
+                    case Compare::Greater:
+                        return select(values, [&](const auto &lhs) { return lhs > rhs; });
+                }
+                return std::vector<Id>{};
+            },
+            operand);
+    }
+
+    // count, sum, min and max of a numeric or bool column, nullopt for string ones
+    std::optional<ColumnAggregate> aggregate(uint32_t column) const {
+        if (!has_column(column)) {
+            return std::nullopt;
+        }
+        return visit_column(column, [](auto values) -> std::optional<ColumnAggregate> {
+            using T = typename decltype(values)::value_type;
+            if constexpr (std::is_same_v<T, std::string>) {
+                return std::nullopt;
+            } else {
+                using Sum = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+                ColumnAggregate res{.count = values.size(), .sum = Sum{0}, .min = std::nullopt, .max = std::nullopt};
+                if (values.empty()) {
+                    return res;
+                }
+                Sum sum = 0;
+                T lo = values[0];
+                T hi = values[0];
+                for (T value : values) {
+                    sum += value;
+                    lo = std::min(lo, value);
+                    hi = std::max(hi, value);
+                }
+                res.sum = sum;
+                res.min = lo;
+                res.max = hi;
+                return res;
+            }
+        });
+    }
+
+    void reserve_at_least(uint32_t new_capacity) {
+        if (new_capacity <= capacity()) {
+            return;
+        }
+        new_capacity = std::max(new_capacity, capacity() * 2);
+        index_.reserve_at_least(new_capacity);
+        for (auto &column : columns_) {
+            std::visit([&](auto &column) { column.realloc(new_capacity, count()); }, column);
+        }
+    }
+
+    uint32_t count() const noexcept { return index_.count(); }
+
+    uint32_t capacity() const noexcept { return index_.capacity(); }
+
+private:
+    template <class Vector>
+    using ValueOf = typename std::remove_cvref_t<Vector>::value_type;
+
+    static Column make_column(ColumnType type) {
+        switch (type) {
+            case ColumnType::Int32:
+                return ThinVector<int32_t>{};
+            case ColumnType::Int64:
+                return ThinVector<int64_t>{};
+            case ColumnType::Double:
+                return ThinVector<double>{};
+            case ColumnType::Bool:
+                return ThinVector<bool>{};
+            case ColumnType::String:
+                return ThinVector<std::string>{};
+        }
+        assert(false);
+        return {};
+    }
+
+    // counts matches first, then writes Id of every row and advances only when pred holds, thus neither
+    //   pass branches per row. One spare slot takes the write past the last match
+    template <class T, class Pred>
+    std::vector<Id> select(std::span<const T> values, Pred &&pred) const {
+        size_t n = 0;
+        for (const T &value : values) {
+            n += static_cast<bool>(pred(value));
+        }
+        std::vector<Id> res(n + 1);
+        const Id *ids = index_.begin();
+        n = 0;
+        for (uint32_t row = 0; row < values.size(); ++row) {
+            res[n] = ids[row];
+            n += static_cast<bool>(pred(values[row]));
+        }
+        res.pop_back();
+        return res;
+    }
+
+    template <class Values>
+    bool matches(std::span<const Values> values) const noexcept {
+        if (values.size() != columns_.size()) {
+            return false;
+        }
+        for (uint32_t i = 0; i < columns_.size(); ++i) {
+            if (values[i].index() != columns_[i].index()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void destroy() noexcept {
+        for (auto &column : columns_) {
+            std::visit(
+                [&](auto &column) {
+                    column.destroy(count());
+                    column.dealloc();
+                },
+                column);
+        }
+        index_.dealloc();
+    }
+
+private:
+    std::vector<ColumnSpec> schema_;
+    std::vector<Column> columns_;  // by schema_ order, alternative index is ColumnType
+    Index index_;
+};
+}  // namespace tablez::dense
@@ -0,0 +1,416 @@
+#pragma once
+
+#include <tablez/id.h>
+#include <tablez/util.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "index.h"
+#include "table.h"
+#include "thin_vector.h"
+
+namespace tablez::dense {
+
+template <class T>
+concept Packable = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+namespace detail {
+
+constexpr uint32_t PACK_BLOCK = 128;
+
+// one kernel per width: constant shifts and trip count let compiler unroll and vectorize it
+template <uint32_t Width>
+void unpack(const uint64_t *words, uint64_t *out) noexcept {
+    if constexpr (Width == 0) {
+        std::fill_n(out, PACK_BLOCK, 0);
+    } else {
+        constexpr uint64_t MASK = Width == 64 ? ~uint64_t{0} : (uint64_t{1} << Width) - 1;
+        for (uint32_t i = 0; i < PACK_BLOCK; ++i) {
+            uint32_t bit = i * Width;
+            uint32_t shift = bit % 64;
+            const uint64_t *at = words + bit / 64;
+            // split shift keeps it defined for shift == 0, reads one word past the block, thus storage is padded
+            out[i] = ((at[0] >> shift) | ((at[1] << 1) << (63 - shift))) & MASK;
+        }
+    }
+}
+
+using Unpacker = void (*)(const uint64_t *, uint64_t *) noexcept;
+
+template <uint32_t... Widths>
+constexpr std::array<Unpacker, sizeof...(Widths)> make_unpackers(std::integer_sequence<uint32_t, Widths...>) {
+    return {&unpack<Widths>...};
+}
+
+inline constexpr auto UNPACKERS = make_unpackers(std::make_integer_sequence<uint32_t, 65>{});
+
+// words must be zeroed
+inline void pack(const uint64_t *values, uint32_t width, uint64_t *words) noexcept {
+    if (width == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < PACK_BLOCK; ++i) {
+        uint32_t bit = i * width;
+        uint32_t shift = bit % 64;
+        uint64_t *at = words + bit / 64;
+        at[0] |= values[i] << shift;
+        if (shift + width > 64) {
+            at[1] |= values[i] >> (64 - shift);
+        }
+    }
+}
+}  // namespace detail
+
+// read-only integer column, split into blocks of BLOCK_SIZE values. Each block is bit-packed either
+//   as frame-of-reference (value - min) or as delta (value - previous - min delta), whichever is narrower
+template <Packable T>
+class PackedColumn {
+    struct Block {
+        uint64_t base;    // minimum for frame-of-reference, first value for delta
+        uint64_t step;    // minimal delta, unused for frame-of-reference
+        uint32_t offset;  // into words_
+        uint8_t width;
+        bool delta;
+    };
+
+public:
+    static constexpr uint32_t BLOCK_SIZE = detail::PACK_BLOCK;
+
+    using Sum = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+
+    static PackedColumn encode(std::span<const T> values) {
+        PackedColumn column;
+        column.count_ = values.size();
+        column.blocks_.reserve((values.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+        for (size_t begin = 0; begin < values.size(); begin += BLOCK_SIZE) {
+            column.encode_block(values.subspan(begin, std::min<size_t>(BLOCK_SIZE, values.size() - begin)));
+        }
+        column.words_.push_back(0);  // padding for unpack, which reads one word ahead
+        column.words_.shrink_to_fit();
+        return column;
+    }
+
+    uint32_t count() const noexcept { return count_; }
+
+    uint32_t block_count() const noexcept { return blocks_.size(); }
+
+    // fills BLOCK_SIZE raw values, returns how many of them belong to the column
+    uint32_t decode_block(uint32_t block_idx, uint64_t *out) const noexcept {
+        assert(block_idx < blocks_.size());
+        const Block &block = blocks_[block_idx];
+        detail::UNPACKERS[block.width](words_.data() + block.offset, out);
+        if (block.delta) {
+            uint64_t prev = block.base;
+            out[0] = prev;
+            for (uint32_t i = 1; i < BLOCK_SIZE; ++i) {
+                prev += block.step + out[i];
+                out[i] = prev;
+            }
+        } else {
+            for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+                out[i] += block.base;
+            }
+        }
+        return std::min(BLOCK_SIZE, count_ - block_idx * BLOCK_SIZE);
+    }
+
+    void decode(T *out) const noexcept {
+        uint64_t buf[BLOCK_SIZE];
+        for (uint32_t block = 0; block < blocks_.size(); ++block) {
+            uint32_t n = decode_block(block, buf);
+            for (uint32_t i = 0; i < n; ++i) {
+                out[block * BLOCK_SIZE + i] = static_cast<T>(buf[i]);
+            }
+        }
+    }
+
+    Sum sum() const noexcept {
+        uint64_t sum = 0;  // wraps the same way as Sum would
+        uint64_t buf[BLOCK_SIZE];
+        for (uint32_t block_idx = 0; block_idx < blocks_.size(); ++block_idx) {
+            const Block &block = blocks_[block_idx];
+            if (block.delta) {
+                uint32_t n = decode_block(block_idx, buf);
+                for (uint32_t i = 0; i < n; ++i) {
+                    sum += static_cast<uint64_t>(static_cast<Sum>(static_cast<T>(buf[i])));
+                }
+            } else {
+                // frame-of-reference: n * base + sum of offsets, padding offsets are zero
+                uint32_t n = std::min(BLOCK_SIZE, count_ - block_idx * BLOCK_SIZE);
+                detail::UNPACKERS[block.width](words_.data() + block.offset, buf);
+                uint64_t offsets = 0;
+                for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+                    offsets += buf[i];
+                }
+                sum += n * static_cast<uint64_t>(static_cast<Sum>(static_cast<T>(block.base))) + offsets;
+            }
+        }
+        return static_cast<Sum>(sum);
+    }
+
+    size_t memory_bytes() const noexcept {
+        return sizeof(Block) * blocks_.capacity() + sizeof(uint64_t) * words_.capacity();
+    }
+
+private:
+    void encode_block(std::span<const T> values) {
+        uint64_t raw[BLOCK_SIZE] = {};
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            raw[i] = static_cast<uint64_t>(values[i]);
+        }
+
+        auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+        uint32_t for_width = std::bit_width(static_cast<uint64_t>(*hi) - static_cast<uint64_t>(*lo));
+
+        // deltas are compared as signed, so slowly decreasing sequences pack as well
+        int64_t step_lo = 0;
+        int64_t step_hi = 0;
+        for (uint32_t i = 1; i < values.size(); ++i) {
+            auto step = static_cast<int64_t>(raw[i] - raw[i - 1]);
+            step_lo = i == 1 ? step : std::min(step_lo, step);
+            step_hi = i == 1 ? step : std::max(step_hi, step);
+        }
+        uint32_t delta_width = std::bit_width(static_cast<uint64_t>(step_hi) - static_cast<uint64_t>(step_lo));
+
+        Block block{};
+        block.offset = static_cast<uint32_t>(words_.size());
+        uint64_t offsets[BLOCK_SIZE] = {};
+        if (values.size() > 1 && delta_width < for_width) {
+            block.base = raw[0];
+            block.step = static_cast<uint64_t>(step_lo);
+            block.width = delta_width;
+            block.delta = true;
+            for (uint32_t i = 1; i < values.size(); ++i) {
+                offsets[i] = raw[i] - raw[i - 1] - block.step;
+            }
+        } else {
+            block.base = static_cast<uint64_t>(*lo);
+            block.step = 0;
+            block.width = for_width;
+            block.delta = false;
+            for (uint32_t i = 0; i < values.size(); ++i) {
+                offsets[i] = raw[i] - block.base;
+            }
+        }
+
+        words_.resize(words_.size() + BLOCK_SIZE * block.width / 64);
+        detail::pack(offsets, block.width, words_.data() + block.offset);
+        blocks_.push_back(block);
+    }
+
+private:
+    std::vector<Block> blocks_;
+    std::vector<uint64_t> words_;
+    uint32_t count_ = 0;
+};
+
+template <class T>
+struct FrozenColumnOf {
+    using Type = ThinVector<T>;
+};
+
+template <Packable T>
+struct FrozenColumnOf<T> {
+    using Type = PackedColumn<T>;
+};
+
+template <class T>
+using FrozenColumn = typename FrozenColumnOf<T>::Type;
+
+// read-optimized form of Table: integer columns and Ids get compressed with PackedColumn,
+//   other columns are kept as they were. Ids of the table stay valid through freeze() and thaw()
+template <class... Ts>
+class FrozenTable {
+    // columns are read by row, presence bits of Optional columns aren't carried over
+    static_assert((!IsOptional<Ts> && ...), "FrozenTable doesn't support Optional columns");
+
+    static constexpr uint32_t BLOCK_SIZE = detail::PACK_BLOCK;
+
+public:
+    constexpr FrozenTable() noexcept = default;
+
+    FrozenTable(FrozenTable &&rhs) noexcept
+        : count_{std::exchange(rhs.count_, 0)},
+          gen_floor_{rhs.gen_floor_},
+          gens_{std::move(rhs.gens_)},
+          idxs_{std::move(rhs.idxs_)},
+          columns_{std::move(rhs.columns_)} {
+        (..., reset_column<Ts>(rhs));
+    }
+
+    FrozenTable &operator=(FrozenTable &&rhs) noexcept {
+        if (this == &rhs) {
+            return *this;
+        }
+        destroy();
+        count_ = std::exchange(rhs.count_, 0);
+        gen_floor_ = rhs.gen_floor_;
+        gens_ = std::move(rhs.gens_);
+        idxs_ = std::move(rhs.idxs_);
+        columns_ = std::move(rhs.columns_);
+        (..., reset_column<Ts>(rhs));
+        return *this;
+    }
+
+    ~FrozenTable() noexcept { destroy(); }
+
+    static FrozenTable freeze(Table<Ts...> &&table) {
+        FrozenTable frozen;
+        frozen.count_ = table.count();
+        frozen.gen_floor_ = table.index_.gen_floor();
+
+        auto slots = table.index_.slots();
+        std::vector<uint32_t> gens(slots.size());
+        std::vector<uint32_t> idxs(slots.size());
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            gens[i] = slots[i].gen();
+            idxs[i] = slots[i].idx();
+        }
+        frozen.gens_ = PackedColumn<uint32_t>::encode(gens);
+        frozen.idxs_ = PackedColumn<uint32_t>::encode(idxs);
+
+        (..., frozen.freeze_column<Ts>(table));
+        table.index_.dealloc();
+        return frozen;
+    }
+
+    Table<Ts...> thaw() && {
+        std::vector<uint32_t> gens(gens_.count());
+        std::vector<uint32_t> idxs(idxs_.count());
+        gens_.decode(gens.data());
+        idxs_.decode(idxs.data());
+
+        std::vector<Id> slots;
+        slots.reserve(gens.size());
+        for (uint32_t i = 0; i < gens.size(); ++i) {
+            slots.emplace_back(gens[i], idxs[i]);
+        }
+
+        Table<Ts...> table;
+        table.index_ = Index::from_slots(slots, count_, gen_floor_);
+        (..., thaw_column<Ts>(table));
+
+        count_ = 0;  // columns are moved out already
+        *this = FrozenTable{};
+        return table;
+    }
+
+    uint32_t count() const noexcept { return count_; }
+
+    template <class T, class Func>
+        requires(IsUniqueAmong<T, Ts...> && std::is_invocable_r_v<void, Func, Id, const T &>)
+    void for_each(Func &&func) const noexcept(std::is_nothrow_invocable_v<Func, Id, const T &>) {
+        uint64_t gens[BLOCK_SIZE];
+        uint64_t idxs[BLOCK_SIZE];
+        [[maybe_unused]] uint64_t values[BLOCK_SIZE];
+        for (uint32_t block = 0; block * BLOCK_SIZE < count_; ++block) {
+            uint32_t base = block * BLOCK_SIZE;
+            uint32_t n = std::min(BLOCK_SIZE, count_ - base);
+            gens_.decode_block(block, gens);
+            idxs_.decode_block(block, idxs);
+            if constexpr (Packable<T>) {
+                column<T>().decode_block(block, values);
+                for (uint32_t i = 0; i < n; ++i) {
+                    const T value = static_cast<T>(values[i]);
+                    func(Id{static_cast<uint32_t>(gens[i]), static_cast<uint32_t>(idxs[i])}, value);
+                }
+            } else {
+                for (uint32_t i = 0; i < n; ++i) {
+                    const T &value = column<T>().get_unchecked(base + i);
+                    func(Id{static_cast<uint32_t>(gens[i]), static_cast<uint32_t>(idxs[i])}, value);
+                }
+            }
+        }
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && Packable<T>)
+    auto sum() const noexcept {
+        return column<T>().sum();
+    }
+
+    // heap footprint of compressed Ids and columns, not including strings' own allocations
+    size_t memory_bytes() const noexcept {
+        return gens_.memory_bytes() + idxs_.memory_bytes() + (... + column_bytes<Ts>());
+    }
+
+private:
+    template <class T>
+    const FrozenColumn<T> &column() const noexcept {
+        return std::get<FrozenColumn<T>>(columns_);
+    }
+
+    template <class T>
+    FrozenColumn<T> &column() noexcept {
+        return std::get<FrozenColumn<T>>(columns_);
+    }
+
+    template <class T>
+    void freeze_column(Table<Ts...> &table) {
+        auto &raw = table.template raw_column<T>();
+        if constexpr (Packable<T>) {
+            column<T>() = PackedColumn<T>::encode(raw.span(count_));
+            raw.dealloc();
+        } else {
+            column<T>() = std::exchange(raw, ThinVector<T>{});
+        }
+    }
+
+    template <class T>
+    void thaw_column(Table<Ts...> &table) {
+        auto &raw = table.template raw_column<T>();
+        if constexpr (Packable<T>) {
+            if (table.capacity() > 0) {
+                raw.realloc(table.capacity(), 0);
+                column<T>().decode(raw.span(count_).data());
+            }
+        } else {
+            raw = std::exchange(column<T>(), ThinVector<T>{});
+        }
+    }
+
+    template <class T>
+    void reset_column(FrozenTable &rhs) noexcept {
+        if constexpr (!Packable<T>) {
+            rhs.column<T>() = ThinVector<T>{};
+        }
+    }
+
+    template <class T>
+    size_t column_bytes() const noexcept {
+        if constexpr (Packable<T>) {
+            return column<T>().memory_bytes();
+        } else {
+            return sizeof(T) * gens_.count();
+        }
+    }
+
+    void destroy() noexcept {
+        (..., destroy_column<Ts>());
+        count_ = 0;
+    }
+
+    template <class T>
+    void destroy_column() noexcept {
+        if constexpr (!Packable<T>) {
+            column<T>().destroy(count_);
+            column<T>().dealloc();
+        }
+    }
+
+private:
+    uint32_t count_ = 0;
+    uint32_t gen_floor_ = Id::EMPTY_GEN;  // of Index, slots dropped by shrinking must stay invalid after thaw()
+    PackedColumn<uint32_t> gens_;  // generations of Index::slots()
+    PackedColumn<uint32_t> idxs_;  // indices of Index::slots()
+    std::tuple<FrozenColumn<Ts>...> columns_;
+};
+}  // namespace tablez::dense
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <tablez/id.h>
+#include <tablez/util.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -9,15 +10,52 @@
 
 namespace tablez::dense {
 
-class Index {
+template <class Policy>
+class BasicIndex {
+    using Id = BasicId<Policy>;
+    using Value = typename Policy::Value;
+
     // looks like Id, but actually index into ids_ storage
-    //   with generation stored
+    //   with generation stored, packed the same way, so it wraps the same
     struct GenIdx {
-        uint32_t gen = Id::EMPTY_GEN;
-        uint32_t idx;
+        Value gen : Id::GEN_BITS = Id::EMPTY_GEN;
+        Value idx : Id::IDX_BITS;
     };
 
 public:
+    static constexpr size_t SLOT_BYTES = sizeof(GenIdx) + sizeof(Id);  // memory taken by every slot
+
+    // rebuilds index from the layout of slots(): first count Ids are alive, the rest are free
+    static BasicIndex from_slots(std::span<const Id> slots, uint32_t count, uint32_t gen_floor = Id::EMPTY_GEN) {
+        assert(count <= slots.size());
+        BasicIndex index;
+        index.gen_floor_ = gen_floor;
+        index.capacity_ = slots.size();
+        index.count_ = count;
+        index.index_ = new GenIdx[index.capacity_];
+        index.ids_ = new Id[index.capacity_];
+        for (uint32_t i = 0; i < index.capacity_; ++i) {
+            Id id = slots[i];
+            assert(id.idx() < index.capacity_);
+            index.ids_[i] = id;
+            index.index_[id.idx()] = {.gen = id.gen(), .idx = i};
+        }
+        return index;
+    }
+
+    // deep copy, index doesn't free its storage by itself
+    BasicIndex clone() const {
+        BasicIndex index;
+        index.gen_floor_ = gen_floor_;
+        index.capacity_ = capacity_;
+        index.count_ = count_;
+        index.index_ = new GenIdx[capacity_];
+        std::copy_n(index_, capacity_, index.index_);
+        index.ids_ = new Id[capacity_];
+        std::copy_n(ids_, capacity_, index.ids_);
+        return index;
+    }
+
     void reserve_at_least(uint32_t new_capacity) {
         if (new_capacity <= capacity_) {
             return;
@@ -29,12 +67,45 @@ public:
         capacity_ = new_capacity;
     }
 
+    // shrinks storage down to new_capacity, but keeps slots of all alive Ids. Returns resulting capacity.
+    //   Generations of dropped slots are kept as a floor for slots added later, so their stale Ids stay invalid
+    uint32_t shrink_to(uint32_t new_capacity) {
+        for (uint32_t i = 0; i < count_; ++i) {
+            new_capacity = std::max(new_capacity, ids_[i].idx() + 1);
+        }
+        if (new_capacity >= capacity_) {
+            return capacity_;
+        }
+        for (uint32_t slot = new_capacity; slot < capacity_; ++slot) {
+            gen_floor_ = std::max<uint32_t>(gen_floor_, index_[slot].gen);
+        }
+
+        auto new_index = new GenIdx[new_capacity];
+        std::copy_n(index_, new_capacity, new_index);
+        auto new_ids = new Id[new_capacity];
+        std::copy_n(ids_, count_, new_ids);
+        uint32_t free_end = count_;
+        for (uint32_t i = count_; i < capacity_; ++i) {
+            if (ids_[i].idx() < new_capacity) {
+                new_index[ids_[i].idx()].idx = free_end;
+                new_ids[free_end++] = ids_[i];
+            }
+        }
+        assert(free_end == new_capacity);
+
+        delete[] index_;
+        delete[] ids_;
+        index_ = new_index;
+        ids_ = new_ids;
+        capacity_ = new_capacity;
+        return capacity_;
+    }
+
     int64_t try_remove(Id id) {
-        if (count_ == 0) {
+        if (count_ == 0 || id.idx() >= capacity_) {
             return -1;
         }
 
-        assert(id.idx() < capacity_);
         assert(!id.is_empty());
         assert(count_ > 0);
         auto &at = index_[id.idx()];
@@ -52,6 +123,19 @@ public:
         return id;
     }
 
+    // makes next n free Ids alive at once, they get rows [count, count + n)
+    std::span<const Id> push_many(uint32_t n) noexcept {
+        assert(count_ + n <= capacity_);
+        uint32_t begin = count_;
+        for (uint32_t row = begin; row < begin + n; ++row) {
+            Id &id = ids_[row];
+            id.make_gen_valid();
+            index_[id.idx()] = {.gen = id.gen(), .idx = row};
+        }
+        count_ += n;
+        return {ids_ + begin, n};
+    }
+
     Id push_realloc() {
         reserve_at_least(count_ + 1);
         return push();
@@ -69,6 +153,11 @@ public:
         return {begin(), end()};
     }
 
+    // whole ids_ storage: alive Ids, followed by free ones
+    std::span<const Id> slots() const noexcept {
+        return {ids_, capacity_};
+    }
+
     uint32_t get_idx_unchecked(Id id) const noexcept {
         assert(id.idx() < capacity_);
         auto idx = index_[id.idx()];
@@ -87,13 +176,24 @@ public:
         return true;
     }
 
+    // doesn't assert on Id out of capacity, fails instead
+    bool try_get_idx_checked(Id id, uint32_t &res) const noexcept {
+        return id.idx() < capacity_ && try_get_idx(id, res);
+    }
+
+    void prefetch(Id id) const noexcept {
+        if (id.idx() < capacity_) {
+            tablez::prefetch(index_ + id.idx());
+        }
+    }
+
     std::optional<uint32_t> try_get_idx(Id id) const noexcept {
         assert(id.idx() < capacity_);
         auto at = index_[id.idx()];
 
         std::optional<uint32_t> res;
         if (at.gen == id.gen()) {
-            res = at.idx;
+            res = static_cast<uint32_t>(at.idx);
         }
         return res;
     }
@@ -102,6 +202,10 @@ public:
         return count_;
     }
 
+    uint32_t gen_floor() const noexcept {
+        return gen_floor_;
+    }
+
     uint32_t capacity() const noexcept {
         return capacity_;
     }
@@ -163,7 +267,7 @@ private:
         }
         for (uint32_t i = capacity_; i < new_capacity; ++i) {
             new_index[i] = {
-                .gen = Id::EMPTY_GEN,
+                .gen = gen_floor_,
                 .idx = i,
             };
         }
@@ -178,7 +282,7 @@ private:
             new_ids[i] = ids_[i];
         }
         for (uint32_t i = capacity_; i < new_capacity; ++i) {
-            new_ids[i] = Id::make_empty(i);
+            new_ids[i] = Id{gen_floor_, i};
         }
         delete[] ids_;
         ids_ = new_ids;
@@ -189,5 +293,9 @@ private:
     uint32_t count_ = 0;
     GenIdx *index_ = nullptr;  // point to actual places of elements
     Id *ids_ = nullptr;        // before count_: store Id of element, after count_: store free Ids
+    uint32_t gen_floor_ = Id::EMPTY_GEN;  // the highest generation of slots dropped by shrink_to()
 };
+
+using Index = BasicIndex<WideIdPolicy>;
+using CompactIndex = BasicIndex<CompactIdPolicy>;
 }  // namespace tablez::dense
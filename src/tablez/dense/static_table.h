@@ -0,0 +1,245 @@
+#pragma once
+
+#include <tablez/id.h>
+#include <tablez/inline_storage.h>
+#include <tablez/util.h>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tablez::dense {
+
+// Table of at most N rows with index and columns stored inline, makes no allocations, thus may live
+//   on stack, inside other objects or in shared memory. Has no change tracking, aggregates or shrinking
+template <uint32_t N, class... Ts>
+    requires(N > 0)
+class StaticTable {
+    struct GenIdx {
+        uint32_t gen;
+        uint32_t idx;
+    };
+
+public:
+    static constexpr uint32_t CAPACITY = N;
+
+    StaticTable() noexcept { reset_index(); }
+
+    StaticTable(const StaticTable &rhs) noexcept((std::is_nothrow_copy_constructible_v<Ts> && ...))
+        requires(std::is_copy_constructible_v<Ts> && ...)
+        : StaticTable() {
+        assign_from(rhs);
+    }
+
+    StaticTable(StaticTable &&rhs) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...)) : StaticTable() {
+        assign_from(rhs);
+    }
+
+    // copy and move: *this stays as it was if a copy throws
+    StaticTable &operator=(const StaticTable &rhs) requires(std::is_copy_constructible_v<Ts> && ...)
+    {
+        if (this != &rhs) {
+            StaticTable copy(rhs);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    // *this is left empty if a move throws
+    StaticTable &operator=(StaticTable &&rhs) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...)) {
+        if (this != &rhs) {
+            destroy();
+            count_ = 0;
+            reset_index();
+            assign_from(rhs);
+        }
+        return *this;
+    }
+
+    ~StaticTable() noexcept { destroy(); }
+
+    // table must not be full()
+    template <class... Us>
+        requires(std::is_constructible_v<Ts, Us &&> && ...)
+    Id insert(Us &&...args) noexcept((std::is_nothrow_constructible_v<Ts, Us> && ...)) {
+        assert(!full());
+        uint32_t row = count_++;
+        Id &id = ids_[row];
+        id.make_gen_valid();
+        index_[id.idx()] = {.gen = id.gen(), .idx = row};
+        (..., raw_column<Ts>().init_at(row, std::forward<Us>(args)));
+        return id;
+    }
+
+    // last row gets moved into place of removed one
+    bool remove(Id id) noexcept(((std::is_nothrow_destructible_v<Ts> && std::is_nothrow_move_assignable_v<Ts>) &&
+                                 ...)) {
+        uint32_t row;
+        if (!find(id, row)) {
+            return false;
+        }
+        uint32_t last = --count_;
+        index_[id.idx()].gen += Id::EMPTY_GEN;
+        index_[ids_[last].idx()].idx = row;
+        ids_[row].make_gen_invalid();
+        std::swap(ids_[row], ids_[last]);
+        if (row != last) {
+            (..., (raw_column<Ts>().at(row) = std::move(raw_column<Ts>().at(last))));
+        }
+        (..., raw_column<Ts>().destroy_at(last));
+        return true;
+    }
+
+    bool contains(Id id) const noexcept {
+        uint32_t row;
+        return find(id, row);
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    T *try_get(Id id) noexcept {
+        uint32_t row;
+        return find(id, row) ? &raw_column<T>().at(row) : nullptr;
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    const T *try_get(Id id) const noexcept {
+        uint32_t row;
+        return find(id, row) ? &raw_column<T>().at(row) : nullptr;
+    }
+
+    template <class T, class U>
+        requires(IsUniqueAmong<T, Ts...> && std::is_assignable_v<T &, U &&>)
+    bool set(Id id, U &&value) noexcept(std::is_nothrow_assignable_v<T &, U &&>) {
+        T *at = try_get<T>(id);
+        if (at == nullptr) {
+            return false;
+        }
+        *at = std::forward<U>(value);
+        return true;
+    }
+
+    template <class Func>
+        requires(std::is_invocable_r_v<void, Func, Id, Ts &...>)
+    void for_each_row(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, Ts &...>) {
+        std::tuple<Ts *...> columns{raw_column<Ts>().data()...};
+        for (uint32_t row = 0; row < count_; ++row) {
+            func(ids_[row], std::get<Ts *>(columns)[row]...);
+        }
+    }
+
+    template <class T, class Func>
+        requires(std::is_invocable_r_v<void, Func, Id, T &>)
+    void for_each(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, T &>) {
+        T *values = raw_column<T>().data();
+        for (uint32_t row = 0; row < count_; ++row) {
+            func(ids_[row], values[row]);
+        }
+    }
+
+    // values of column T in row order
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    std::span<const T> values() const noexcept {
+        return {raw_column<T>().data(), count_};
+    }
+
+    std::span<const Id> ids() const noexcept { return {ids_.data(), count_}; }
+
+    void clear() noexcept {
+        for (uint32_t row = 0; row < count_; ++row) {
+            index_[ids_[row].idx()].gen += Id::EMPTY_GEN;
+            ids_[row].make_gen_invalid();
+        }
+        destroy();
+        count_ = 0;
+    }
+
+    uint32_t count() const noexcept { return count_; }
+
+    static constexpr uint32_t capacity() noexcept { return N; }
+
+    bool full() const noexcept { return count_ == N; }
+
+private:
+    bool find(Id id, uint32_t &row) const noexcept {
+        if (id.idx() >= N || index_[id.idx()].gen != id.gen()) {
+            return false;
+        }
+        row = index_[id.idx()].idx;
+        return true;
+    }
+
+    void destroy() noexcept {
+        if constexpr (!(std::is_trivially_destructible_v<Ts> && ...)) {
+            for (uint32_t row = 0; row < count_; ++row) {
+                (..., raw_column<Ts>().destroy_at(row));
+            }
+        }
+    }
+
+    void reset_index() noexcept {
+        for (uint32_t i = 0; i < N; ++i) {
+            index_[i] = {.gen = Id::EMPTY_GEN, .idx = i};
+            ids_[i] = Id::make_empty(i);
+        }
+    }
+
+    // *this must have no rows. Copies rows of const rhs, moves them otherwise. Takes index after all
+    //   values got constructed, thus stays empty on throw
+    template <class Rhs>
+    void assign_from(Rhs &rhs) {
+        init_columns<0>(rhs);
+        index_ = rhs.index_;
+        ids_ = rhs.ids_;
+        count_ = rhs.count_;
+    }
+
+    // constructs column I and the ones after it, if any value throws, values constructed so far get destroyed
+    template <size_t I, class Rhs>
+    void init_columns(Rhs &rhs) {
+        if constexpr (I < sizeof...(Ts)) {
+            auto &col = std::get<I>(columns_);
+            auto &from = std::get<I>(rhs.columns_);
+            uint32_t row = 0;
+            try {
+                for (; row < rhs.count_; ++row) {
+                    if constexpr (std::is_const_v<Rhs>) {
+                        col.init_at(row, from.at(row));
+                    } else {
+                        col.init_at(row, std::move(from.at(row)));
+                    }
+                }
+                init_columns<I + 1>(rhs);
+            } catch (...) {
+                for (uint32_t at = 0; at < row; ++at) {
+                    col.destroy_at(at);
+                }
+                throw;
+            }
+        }
+    }
+
+    template <class T>
+    InlineStorage<T, N> &raw_column() noexcept {
+        return std::get<IndexOf<T, Ts...>>(columns_);
+    }
+
+    template <class T>
+    const InlineStorage<T, N> &raw_column() const noexcept {
+        return std::get<IndexOf<T, Ts...>>(columns_);
+    }
+
+private:
+    std::array<GenIdx, N> index_;  // by slot: generation and row
+    std::array<Id, N> ids_;        // by row: alive Ids before count_, free ones after
+    uint32_t count_ = 0;
+    std::tuple<InlineStorage<Ts, N>...> columns_;
+};
+}  // namespace tablez::dense
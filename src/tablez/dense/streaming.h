@@ -0,0 +1,142 @@
+#pragma once
+
+#include <tablez/id.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "cow_table.h"
+
+namespace tablez::dense {
+
+struct PublishPolicy {
+    uint32_t batch_rows = 1024;            // publish once that many changes are pending, 0 disables
+    std::chrono::nanoseconds interval{0};  // publish once the oldest pending change is that old, 0 disables
+};
+
+// table for streaming ingest by a single producer: writer inserts and removes in a CowTable, readers see
+//   only published Snapshots. Publishing takes a snapshot, which costs O(chunks) and shares rows with the
+//   writer until it touches them. Published pointer is kept in two slots, left-right style: writer stores
+//   into the slot readers don't read and flips them over. Readers still copying the old slot are drained
+//   only by the next publish, right before it reuses the slot; they are long gone by then unless publishes
+//   come back to back, so ingest practically never waits on readers. The price is that the previous
+//   snapshot stays alive until the next publish. latest() takes no lock and never waits, neither on the
+//   writer nor on other readers, thus query latency doesn't depend on ingest bursts. Everything but
+//   latest() must be called from the writer thread
+template <class... Ts>
+class StreamingTable {
+    using Clock = std::chrono::steady_clock;
+
+public:
+    using Published = std::shared_ptr<const Snapshot<Ts...>>;
+
+    explicit StreamingTable(PublishPolicy policy = {})
+        : policy_{policy}, slots_{std::make_shared<const Snapshot<Ts...>>(), nullptr} {}
+
+    StreamingTable(const StreamingTable &) = delete;
+    StreamingTable &operator=(const StreamingTable &) = delete;
+
+    template <class... Us>
+        requires(std::is_constructible_v<Ts, Us &&> && ...)
+    Id insert(Us &&...args) {
+        Id id = table_.insert(std::forward<Us>(args)...);
+        changed();
+        return id;
+    }
+
+    bool remove(Id id) {
+        if (!table_.remove(id)) {
+            return false;
+        }
+        changed();
+        return true;
+    }
+
+    // writer side, including changes not published yet
+    const CowTable<Ts...> &writer() const noexcept { return table_; }
+
+    // makes pending changes visible to readers
+    void publish() {
+        if (pending_ == 0) {
+            return;
+        }
+        uint32_t active = active_.load();
+        Published published = std::make_shared<const Snapshot<Ts...>>(table_.snapshot());
+        reclaim(1 - active);
+        slots_[1 - active] = std::move(published);
+        active_.store(1 - active);
+        pending_ = 0;
+    }
+
+    // publishes if the policy says so, for writer to call while there is nothing to ingest, so that
+    //   interval holds without new changes
+    void maybe_publish() {
+        if (pending_ == 0) {
+            return;
+        }
+        if ((policy_.batch_rows != 0 && pending_ >= policy_.batch_rows) ||
+            (policy_.interval.count() != 0 && Clock::now() - pending_since_ >= policy_.interval)) {
+            publish();
+        }
+    }
+
+    // the latest published snapshot, from any thread. Stays valid and unchanged while held. Wait-free:
+    //   a fixed number of atomic operations, whatever the writer does
+    Published latest() const noexcept {
+        uint32_t version = version_.load();
+        readers_[version].count.fetch_add(1);
+        Published published = slots_[active_.load()];
+        readers_[version].count.fetch_sub(1);
+        return published;
+    }
+
+    uint32_t pending() const noexcept { return pending_; }
+
+private:
+    void changed() {
+        if (pending_++ == 0 && policy_.interval.count() != 0) {
+            pending_since_ = Clock::now();
+        }
+        maybe_publish();
+    }
+
+    // waits for readers that may still copy the slot retired by the previous publish, then releases it,
+    //   unless a reader holds it
+    void reclaim(uint32_t slot) noexcept {
+        if (!slots_[slot]) {
+            return;
+        }
+        // readers registered on either counter may still copy it, drain both in turn
+        uint32_t version = version_.load();
+        drain(1 - version);
+        version_.store(1 - version);
+        drain(version);
+        slots_[slot].reset();
+    }
+
+    void drain(uint32_t version) const noexcept {
+        while (readers_[version].count.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    struct alignas(64) Readers {
+        std::atomic<uint32_t> count = 0;
+    };
+
+    CowTable<Ts...> table_;
+    PublishPolicy policy_;
+    uint32_t pending_ = 0;  // changes since last publish
+    Clock::time_point pending_since_;
+    Published slots_[2];                // slots_[active_] is read, the other one was retired by the last publish()
+    std::atomic<uint32_t> active_ = 0;
+    std::atomic<uint32_t> version_ = 0;  // counter of readers_ new readers register on
+    mutable Readers readers_[2];         // readers between loading version_ and copying out their slot
+};
+}  // namespace tablez::dense
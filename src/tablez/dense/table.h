@@ -1,31 +1,79 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <ranges>
+#include <span>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "index.h"
+#include "tablez/aggregate.h"
+#include "tablez/changes.h"
+#include "tablez/optional.h"
+#include "tablez/stats.h"
 #include "tablez/util.h"
+#include "tablez/zone_map.h"
 #include "thin_vector.h"
 
+namespace tablez::detail {
+template <class Table>
+struct ViewAccess;
+}  // namespace tablez::detail
+
+namespace tablez::hybrid {
+template <class... Ts>
+class Table;
+}  // namespace tablez::hybrid
+
 namespace tablez::dense {
 
 template <class... Ts>
-class Table {
+class FrozenTable;
+
+// rows are packed at [0, count) of every column, Ids get issued by Policy, see id.h
+template <class Policy, class... Ts>
+class BasicTable {
+    friend class FrozenTable<Ts...>;
+    friend class hybrid::Table<Ts...>;
+    friend struct detail::ViewAccess<BasicTable>;
+
+    static constexpr uint32_t CLONE_CHUNK = 1 << 16;  // rows per thread at least
+    static constexpr bool NOTHROW_COPY =
+        (noexcept(std::declval<ThinVector<Ts> &>().copy_in(0, std::declval<const ThinVector<Ts> &>(), 0, 0)) && ...);
+
 public:
-    static Table with_capacity(uint32_t capacity) {
-        Table table;
+    using Id = BasicId<Policy>;
+    using Index = BasicIndex<Policy>;
+    using IdRemap = BasicIdRemap<Policy>;
+
+    static BasicTable with_capacity(uint32_t capacity) {
+        BasicTable table;
         table.reserve_at_least(capacity);
         return table;
     }
 
-    constexpr Table() noexcept = default;
+    constexpr BasicTable() noexcept = default;
 
-    Table(Table &&rhs) noexcept : index_(rhs.index_), columns_(rhs.columns_) {
+    BasicTable(BasicTable &&rhs) noexcept
+        : index_(rhs.index_),
+          columns_(rhs.columns_),
+          changes_(std::exchange(rhs.changes_, {})),
+          version_(rhs.version_),
+          tracked_(std::exchange(rhs.tracked_, 0)),
+          aggregates_(std::exchange(rhs.aggregates_, {})),
+          aggregated_(std::exchange(rhs.aggregated_, 0)),
+          zones_(std::exchange(rhs.zones_, {})),
+          zoned_(std::exchange(rhs.zoned_, 0)),
+          shrink_policy_(rhs.shrink_policy_),
+          shrink_check_at_(rhs.shrink_check_at_),
+          stats_(rhs.stats_) {
         rhs.index_ = {};
         rhs.columns_ = {};
     }
 
-    Table &operator=(Table &&rhs) noexcept {
+    BasicTable &operator=(BasicTable &&rhs) noexcept {
         if (this == &rhs) {
             return *this;
         }
@@ -33,10 +81,20 @@ public:
         dealloc();
         index_ = std::exchange(rhs.index_, Index{});
         (..., (raw_column<Ts>() = std::exchange(rhs.raw_column<Ts>(), ThinVector<Ts>{})));
+        changes_ = std::exchange(rhs.changes_, {});
+        version_ = rhs.version_;
+        tracked_ = std::exchange(rhs.tracked_, 0);
+        aggregates_ = std::exchange(rhs.aggregates_, {});
+        aggregated_ = std::exchange(rhs.aggregated_, 0);
+        zones_ = std::exchange(rhs.zones_, {});
+        zoned_ = std::exchange(rhs.zoned_, 0);
+        shrink_policy_ = rhs.shrink_policy_;
+        shrink_check_at_ = rhs.shrink_check_at_;
+        stats_ = rhs.stats_;
         return *this;
     }
 
-    ~Table() noexcept {
+    ~BasicTable() noexcept {
         destroy();
         dealloc();
     }
@@ -48,52 +106,601 @@ public:
         auto last = count();
         Id id = index_.push();
         (..., raw_column<Ts>().insert_at(last, std::forward<Us>(args)));
+        if (aggregated_ != 0) {
+            (..., aggregate_of<Ts>().add(raw_column<Ts>().get_unchecked(last)));
+        }
+        if (zoned_ != 0) {
+            (..., zone_of<Ts>().push(last, raw_column<Ts>().get_unchecked(last)));
+        }
+        touch_row(last);
+        stats_.add(&TableStats::inserts);
         return id;
     }
 
-    bool remove(Id id) noexcept(((std::is_nothrow_destructible_v<Ts> && std::is_nothrow_move_assignable_v<Ts>) &&
-                                 ...)) {
-        int64_t replaced_idx = index_.try_remove(id);
-        if (replaced_idx < 0) {
-            return false;
+    // moves values of every column in as new rows with one reservation, ranges must be of the same size.
+    //   Returns Ids of new rows, valid until next insert or remove
+    template <class... Rs>
+        requires(sizeof...(Rs) == sizeof...(Ts) &&
+                 ((std::ranges::random_access_range<Rs> && std::ranges::sized_range<Rs>) && ...) &&
+                 (std::is_constructible_v<Ts, std::ranges::range_rvalue_reference_t<Rs>> && ...))
+    std::span<const Id> insert_many(Rs &&...values) {
+        uint32_t n = std::ranges::size(std::get<0>(std::tie(values...)));
+        assert(((std::ranges::size(values) == n) && ...));
+        reserve_at_least(count() + n);
+        uint32_t begin = count();
+        for (uint32_t i = 0; i < n; ++i) {
+            (..., raw_column<Ts>().insert_at(begin + i, std::ranges::iter_move(std::ranges::begin(values) + i)));
         }
+        auto ids = index_.push_many(n);
+        added_rows(begin);
+        return ids;
+    }
 
-        (..., raw_column<Ts>().remove_at(replaced_idx, index_.count()));
+    // deep copy with the same Ids. Index and trivially copyable columns get copied with memcpy, rows are
+    //   split between up to threads threads for big tables. Columns which copies may throw get copied on
+    //   the calling thread only, if one throws, values copied so far get destroyed and it's rethrown
+    BasicTable clone(uint32_t threads = 1) const
+        requires(std::is_copy_constructible_v<Ts> && ...)
+    {
+        // index goes last, until then table has no rows for its destructor to go over
+        BasicTable table;
+        (..., table.raw_column<Ts>().realloc(capacity(), 0));
+        if constexpr (NOTHROW_COPY) {
+            threads = std::clamp<uint32_t>(threads, 1, std::max<uint32_t>(1, count() / CLONE_CHUNK));
+            // chunks are cut at multiples of 64 rows, so that presence bits of Optional columns don't share words
+            parallel_chunks((uint64_t{count()} + 63) / 64, threads, [&](uint32_t begin, uint32_t end) {
+                begin *= 64;
+                end = std::min(end * 64, count());
+                (..., table.raw_column<Ts>().copy_in(begin, raw_column<Ts>(), begin, end - begin));
+            });
+        } else {
+            table.copy_rows<0>(*this, 0);
+        }
+        try {
+            table.index_ = index_.clone();
+        } catch (...) {
+            (..., table.raw_column<Ts>().destroy(0, count()));
+            throw;
+        }
+        table.changes_ = changes_;
+        table.version_ = version_;
+        table.tracked_ = tracked_;
+        table.aggregates_ = aggregates_;
+        table.aggregated_ = aggregated_;
+        table.zones_ = zones_;
+        table.zoned_ = zoned_;
+        table.shrink_policy_ = shrink_policy_;
+        table.shrink_check_at_ = shrink_check_at_;
+        return table;
+    }
+
+    // moves rows of rhs in at the end with one reservation and a bulk move of every column, they get new Ids
+    //   in rows [count, count + n). rhs is left empty, keeping its capacity. Pairs of rhs Id and new one get
+    //   added to remap if given. Returns number of appended rows
+    uint32_t append(BasicTable &&rhs, IdRemap *remap = nullptr) {
+        assert(&rhs != this);
+        uint32_t n = rhs.count();
+        uint32_t begin = count();
+        reserve_at_least(begin + n);
+        (..., raw_column<Ts>().move_in(begin, rhs.raw_column<Ts>(), 0, n));
+        add_remap(remap, rhs.ids(), index_.push_many(n));
+        added_rows(begin);
+        rhs.clear();
+        return n;
+    }
+
+    // same as append, but copies rows of rhs
+    uint32_t merge(const BasicTable &rhs, IdRemap *remap = nullptr)
+        requires(std::is_copy_constructible_v<Ts> && ...)
+    {
+        assert(&rhs != this);
+        uint32_t n = rhs.count();
+        uint32_t begin = count();
+        reserve_at_least(begin + n);
+        copy_rows<0>(rhs, begin);
+        add_remap(remap, rhs.ids(), index_.push_many(n));
+        added_rows(begin);
+        return n;
+    }
+
+    // removes all rows, keeps capacity
+    void clear() noexcept {
+        (..., touch_all<Ts>());
+        (..., aggregate_of<Ts>().invalidate());
+        destroy();
+    }
+
+    // not noexcept: may shrink storage under ShrinkPolicy, which allocates
+    bool remove(Id id) {
+        if (!remove_row(id)) {
+            return false;
+        }
+        maybe_shrink();
         return true;
     }
 
+    // removes rows from the highest one down: rows above are gone by then, thus every remove moves
+    //   at most one row which stays alive. Invalid and repeated Ids are skipped. Returns number of removed rows
+    uint32_t remove_many(std::span<const Id> ids) {
+        std::vector<std::pair<uint32_t, Id>> rows;
+        rows.reserve(ids.size());
+        for (Id id : ids) {
+            uint32_t idx;
+            if (index_.try_get_idx_checked(id, idx)) {
+                rows.emplace_back(idx, id);
+            } else {
+                stats_.add(&TableStats::stale_removes);
+            }
+        }
+        std::sort(rows.begin(), rows.end(), [](auto &lhs, auto &rhs) { return lhs.first > rhs.first; });
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        for (auto [_, id] : rows) {
+            remove_row(id);
+        }
+        maybe_shrink();
+        return rows.size();
+    }
+
     void reserve_at_least(uint32_t new_capacity) {
-        if (new_capacity < capacity()) {
+        if (new_capacity <= capacity()) {
             return;
         }
-        new_capacity = std::max(new_capacity, capacity() * 2);
-        uint32_t old_capacity = capacity();
+        assert(new_capacity - 1 <= Id::MAX_IDX);
+        new_capacity = std::max<uint64_t>(new_capacity, std::min(uint64_t{capacity()} * 2, uint64_t{Id::MAX_IDX} + 1));
+        shrink_check_at_ = UINT32_MAX;
+        [[maybe_unused]] auto timer = stats_.time(&TableStats::grow_ns);
+        count_realloc(capacity());
         index_.reserve_at_least(new_capacity);
         (..., raw_column<Ts>().realloc(new_capacity, count()));
+        for (auto &changes : changes_) {
+            changes.reserve_at_least(new_capacity);
+        }
+        (..., zone_of<Ts>().reserve_at_least(new_capacity));
+    }
+
+    // capacity can't get below the highest slot of alive Ids, as they'd become invalid
+    void shrink_to_fit() { shrink_to(count()); }
+
+    void set_shrink_policy(ShrinkPolicy policy) noexcept {
+        shrink_policy_ = policy;
+        shrink_check_at_ = UINT32_MAX;
     }
 
     uint32_t count() const noexcept { return index_.count(); }
 
     uint32_t capacity() const noexcept { return index_.capacity(); }
 
+    // counters are zero unless built with TABLEZ_STATS, the rest gets computed on call
+    TableStats stats() const {
+        TableStats stats;
+        stats_.fill(stats);
+        stats.count = count();
+        stats.capacity = capacity();
+        stats.index_bytes = uint64_t{capacity()} * Index::SLOT_BYTES;
+        stats.column_bytes = {uint64_t{capacity()} * sizeof(ColumnValue<Ts>)...};
+        // alive rows are packed at front
+        for (uint32_t begin = 0; begin < capacity(); begin += TableStats::OCCUPANCY_BLOCK) {
+            stats.block_occupancy.push_back(std::min(count() - std::min(count(), begin), TableStats::OCCUPANCY_BLOCK));
+        }
+        return stats;
+    }
+
+    // aggregate and zones of T get recomputed on next read, as values may be written through
     template <class T>
-        requires(IsUniqueAmong<T, Ts...>)
-    auto column() const noexcept {
+        requires(IsUniqueAmong<T, Ts...> && !IsOptional<T>)
+    auto column() noexcept {
+        aggregate_of<T>().invalidate();
+        zone_of<T>().invalidate_all();
         return std::ranges::views::iota(uint32_t{0}, count()) | std::ranges::views::transform([this](uint32_t idx) {
                    return std::pair<Id, T &>(index_.get_id_by_idx(idx), raw_column<T>().get_unchecked(idx));
                });
     }
 
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && !IsOptional<T>)
+    auto column() const noexcept {
+        return std::ranges::views::iota(uint32_t{0}, count()) | std::ranges::views::transform([this](uint32_t idx) {
+                   return std::pair<Id, const T &>(index_.get_id_by_idx(idx), raw_column<T>().get_unchecked(idx));
+               });
+    }
+
+    // contiguous values of column T, row i belongs to ids()[i]. Invalidated by any insert or remove
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && !IsOptional<T>)
+    std::span<const T> values() const noexcept {
+        return raw_column<T>().span(count());
+    }
+
+    std::span<const Id> ids() const noexcept { return index_.span(); }
+
+    // for Optional<U> column T gives U *, nullptr also when row has no value
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    ColumnValue<T> *try_get(Id id) noexcept {
+        uint32_t idx;
+        if (!index_.try_get_idx_checked(id, idx) || !has_value<T>(idx)) {
+            return nullptr;
+        }
+        touch<T>(idx);
+        aggregate_of<T>().invalidate();
+        zone_of<T>().invalidate(idx);
+        return &raw_column<T>().get_unchecked(idx);
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    const ColumnValue<T> *try_get(Id id) const noexcept {
+        uint32_t idx;
+        if (!index_.try_get_idx_checked(id, idx) || !has_value<T>(idx)) {
+            return nullptr;
+        }
+        return &raw_column<T>().get_unchecked(idx);
+    }
+
+    // same as writing through try_get, but keeps aggregate of T up to date. Optional column takes
+    //   std::nullopt as well, which drops the value of row
+    template <class T, class U>
+        requires(IsUniqueAmong<T, Ts...> && std::is_assignable_v<T &, U &&>)
+    bool set(Id id, U &&value) noexcept(std::is_nothrow_assignable_v<T &, U &&>) {
+        uint32_t idx;
+        if (!index_.try_get_idx_checked(id, idx)) {
+            return false;
+        }
+        if constexpr (IsOptional<T>) {
+            raw_column<T>().assign_at(idx, std::forward<U>(value));
+        } else {
+            auto &at = raw_column<T>().get_unchecked(idx);
+            aggregate_of<T>().remove(at);
+            zone_of<T>().remove(idx, at);
+            at = std::forward<U>(value);
+            aggregate_of<T>().add(at);
+            zone_of<T>().widen(idx, at);
+        }
+        touch<T>(idx);
+        return true;
+    }
+
+    // rows with a value in Optional column T
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && IsOptional<T>)
+    uint32_t count_present() const noexcept {
+        return raw_column<T>().count_present(count());
+    }
+
+    // copies values of Us columns for every alive ids[i] into out[i] and sets found[i], lookups are pipelined:
+    //   index entries get prefetched 2 * PREFETCH_DISTANCE ahead, column values PREFETCH_DISTANCE ahead.
+    //   Returns number of found Ids
+    template <class... Us>
+        requires((IsUniqueAmong<Us, Ts...> && ...) && ((std::is_copy_assignable_v<Us> && !IsOptional<Us>) && ...))
+    uint32_t get_many(std::span<const Id> ids, std::span<bool> found, std::span<Us>... out) const {
+        assert(found.size() >= ids.size() && ((out.size() >= ids.size()) && ...));
+        uint32_t found_count = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i + 2 * PREFETCH_DISTANCE < ids.size()) {
+                index_.prefetch(ids[i + 2 * PREFETCH_DISTANCE]);
+            }
+            uint32_t ahead;
+            if (i + PREFETCH_DISTANCE < ids.size() && index_.try_get_idx_checked(ids[i + PREFETCH_DISTANCE], ahead)) {
+                (..., raw_column<Us>().prefetch(ahead));
+            }
+
+            uint32_t idx;
+            found[i] = index_.try_get_idx_checked(ids[i], idx);
+            if (found[i]) {
+                ++found_count;
+                (..., (out[i] = raw_column<Us>().get_unchecked(idx)));
+            }
+        }
+        return found_count;
+    }
+
+    bool contains(Id id) const noexcept {
+        uint32_t idx;
+        return index_.try_get_idx_checked(id, idx);
+    }
+
+    template <class Func>
+        requires((!IsOptional<Ts> && ...) && std::is_invocable_r_v<void, Func, Id, Ts &...>)
+    void for_each_row(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, Ts &...>) {
+        if (tracked_ != 0) {
+            ++version_;
+            for (auto &changes : changes_) {
+                changes.mark_all(count(), version_);
+            }
+        }
+        (..., aggregate_of<Ts>().invalidate());
+        (..., zone_of<Ts>().invalidate_all());
+        for (uint32_t i = 0; i < count(); ++i) {
+            func(index_.get_id_by_idx(i), raw_column<Ts>().get_unchecked(i)...);
+        }
+    }
+
+    // Optional column T visits only rows with a value, skipping absent ones word by word
     template <class T, class Func>
-        requires(std::is_invocable_r_v<void, Func, Id, T &>)
-    void for_each(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, T &>) {
+        requires(std::is_invocable_r_v<void, Func, Id, ColumnValue<T> &>)
+    void for_each(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, ColumnValue<T> &>) {
+        touch_all<T>();
+        aggregate_of<T>().invalidate();
+        zone_of<T>().invalidate_all();
         auto &col = raw_column<T>();
-        for (uint32_t i = 0; i < count(); ++i) {
-            func(index_.get_id_by_idx(i), col.get_unchecked(i));
+        if constexpr (IsOptional<T>) {
+            col.for_each_present(count(), [&](uint32_t i) { func(index_.get_id_by_idx(i), col.get_unchecked(i)); });
+        } else {
+            for (uint32_t i = 0; i < count(); ++i) {
+                func(index_.get_id_by_idx(i), col.get_unchecked(i));
+            }
+        }
+    }
+
+    // rows move on remove, thus changes are tracked per chunk of rows: insert, remove, try_get and for_each
+    //   mark chunks they touch, writes through column() are not tracked
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    void track_changes(bool enable = true) {
+        auto &changes = changes_[IndexOf<T, Ts...>];
+        if (enable == changes.enabled()) {
+            return;
+        }
+        if (enable) {
+            changes.enable(capacity());
+            ++tracked_;
+        } else {
+            changes.disable();
+            --tracked_;
+        }
+    }
+
+    uint64_t version() const noexcept { return version_; }
+
+    // visits rows of chunks changed after since version, untracked column is visited whole
+    template <class T, class Func>
+        requires(IsUniqueAmong<T, Ts...> && !IsOptional<T> && std::is_invocable_r_v<void, Func, Id, const T &>)
+    void for_each_changed(uint64_t since, Func &&func) const {
+        auto &col = raw_column<T>();
+        changes_[IndexOf<T, Ts...>].for_each_changed(since, count(), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                func(index_.get_id_by_idx(i), std::as_const(col.get_unchecked(i)));
+            }
+        });
+    }
+
+    // keeps count, sum, min and max of column T, updated by insert, remove and set in O(1)
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && Aggregatable<T>)
+    void track_aggregate(bool enable = true) {
+        auto &aggregate = aggregate_of<T>();
+        if (enable == aggregate.enabled()) {
+            return;
+        }
+        if (enable) {
+            aggregate.enable();
+            ++aggregated_;
+        } else {
+            aggregate.disable();
+            --aggregated_;
+        }
+    }
+
+    // recomputes aggregate if it got stale, O(1) otherwise. Not const, so that readers of a shared
+    //   const table never recompute it concurrently
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && Aggregatable<T>)
+    const Aggregate<T> &aggregate() {
+        auto &aggregate = aggregate_of<T>();
+        assert(aggregate.enabled());
+        if (aggregate.stale()) {
+            aggregate.recompute([this](auto &&add) {
+                for (const T &value : raw_column<T>().span(count())) {
+                    add(value);
+                }
+            });
+        }
+        return aggregate;
+    }
+
+    // keeps min and max of column T per zone of ZONE_ROWS rows, for queries to skip zones no value of which
+    //   can pass their filters. Inserts widen bounds in O(1), removes and writes may leave zones to recompute
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && Aggregatable<T>)
+    void track_zones(bool enable = true) {
+        auto &zones = zone_of<T>();
+        if (enable == zones.enabled()) {
+            return;
+        }
+        if (enable) {
+            zones.enable(capacity());
+            zones.refresh(raw_column<T>().span(count()).data(), count());
+            ++zoned_;
+        } else {
+            zones.disable();
+            --zoned_;
+        }
+    }
+
+    // zones of T as they are, nullptr if they aren't tracked. Zones made dirty by removes and writes don't
+    //   get skipped by queries until refresh_zones(), which const table never does on its own
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && Aggregatable<T>)
+    const ZoneMap<T> *zone_map() const noexcept {
+        auto &zones = zone_of<T>();
+        return zones.enabled() ? &zones : nullptr;
+    }
+
+    // recomputes dirty zones of every tracked column
+    void refresh_zones() noexcept {
+        if (zoned_ != 0) {
+            (..., refresh_zones_of<Ts>());
         }
     }
 
 private:
+    bool remove_row(Id id) noexcept(((std::is_nothrow_destructible_v<Ts> && std::is_nothrow_move_assignable_v<Ts>) &&
+                                     ...)) {
+        [[maybe_unused]] auto timer = stats_.time(&TableStats::remove_ns);
+        int64_t replaced_idx = index_.try_remove(id);
+        if (replaced_idx < 0) {
+            stats_.add(&TableStats::stale_removes);
+            return false;
+        }
+        stats_.add(&TableStats::removes);
+
+        if (aggregated_ != 0) {
+            (..., aggregate_of<Ts>().remove(raw_column<Ts>().get_unchecked(replaced_idx)));
+        }
+        if (zoned_ != 0) {
+            (..., remove_from_zones<Ts>(replaced_idx, index_.count()));
+        }
+        (..., raw_column<Ts>().remove_at(replaced_idx, index_.count()));
+        if (replaced_idx != index_.count()) {
+            touch_row(replaced_idx);  // last row got moved in
+        }
+        return true;
+    }
+
+    // updates aggregates, change trackers and stats for rows [begin, count) which got in
+    void added_rows(uint32_t begin) noexcept {
+        stats_.add(&TableStats::inserts, count() - begin);
+        if (aggregated_ != 0 || tracked_ != 0 || zoned_ != 0) {
+            ++version_;
+            for (uint32_t row = begin; row < count(); ++row) {
+                (..., aggregate_of<Ts>().add(raw_column<Ts>().get_unchecked(row)));
+                (..., zone_of<Ts>().push(row, raw_column<Ts>().get_unchecked(row)));
+                for (auto &changes : changes_) {
+                    changes.mark(row, version_);
+                }
+            }
+        }
+    }
+
+    // copies all rows of rhs into rows from at on, column I and the ones after it, row by row for columns
+    //   which copies may throw. If one does, values copied so far get destroyed
+    template <size_t I>
+    void copy_rows(const BasicTable &rhs, uint32_t at) {
+        if constexpr (I < sizeof...(Ts)) {
+            using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+            auto &col = raw_column<T>();
+            uint32_t row = 0;
+            try {
+                if constexpr (noexcept(col.copy_in(0, rhs.raw_column<T>(), 0, 0))) {
+                    col.copy_in(at, rhs.raw_column<T>(), 0, rhs.count());
+                    row = rhs.count();
+                } else {
+                    for (; row < rhs.count(); ++row) {
+                        col.copy_in(at + row, rhs.raw_column<T>(), row, 1);
+                    }
+                }
+                copy_rows<I + 1>(rhs, at);
+            } catch (...) {
+                col.destroy(at, at + row);
+                throw;
+            }
+        }
+    }
+
+    static void add_remap(IdRemap *remap, std::span<const Id> from, std::span<const Id> to) {
+        if (remap != nullptr) {
+            remap->reserve(remap->size() + from.size());
+            for (uint32_t i = 0; i < from.size(); ++i) {
+                remap->emplace_back(from[i], to[i]);
+            }
+        }
+    }
+
+    void shrink_to(uint32_t new_capacity) {
+        uint32_t old_capacity = capacity();
+        [[maybe_unused]] auto timer = stats_.time(&TableStats::grow_ns);
+        new_capacity = index_.shrink_to(new_capacity);
+        if (new_capacity != old_capacity) {
+            count_realloc(new_capacity);
+            (..., raw_column<Ts>().realloc(new_capacity, count()));
+        }
+    }
+
+    // every realloc moves alive rows and slots of the index kept
+    void count_realloc(uint32_t kept_slots) noexcept {
+        stats_.add(&TableStats::reallocs);
+        stats_.add(&TableStats::bytes_moved,
+                   uint64_t{count()} * (sizeof(ColumnValue<Ts>) + ...) + uint64_t{kept_slots} * Index::SLOT_BYTES);
+    }
+
+    void maybe_shrink() {
+        if (shrink_policy_.low_water > 0 && count() <= shrink_check_at_ &&
+            count() < capacity() * shrink_policy_.low_water && capacity() > shrink_policy_.min_capacity) {
+            // alive slots may keep capacity up, don't retry on every remove then
+            shrink_check_at_ = count() / 2;
+            shrink_to(std::max(count() * 2, shrink_policy_.min_capacity));
+        }
+    }
+
+    template <class T>
+    bool has_value(uint32_t row) const noexcept {
+        if constexpr (IsOptional<T>) {
+            return raw_column<T>().has(row);
+        }
+        return true;
+    }
+
+    template <class T>
+    Aggregate<T> &aggregate_of() noexcept {
+        return std::get<Aggregate<T>>(aggregates_);
+    }
+
+    template <class T>
+    ZoneMap<T> &zone_of() noexcept {
+        return std::get<ZoneMap<T>>(zones_);
+    }
+
+    template <class T>
+    const ZoneMap<T> &zone_of() const noexcept {
+        return std::get<ZoneMap<T>>(zones_);
+    }
+
+    template <class T>
+    void refresh_zones_of() noexcept {
+        if constexpr (Aggregatable<T>) {
+            auto &zones = zone_of<T>();
+            if (zones.enabled()) {
+                zones.refresh(raw_column<T>().span(count()).data(), count());
+            }
+        }
+    }
+
+    // value of last row moves into row, both zones lose a value
+    template <class T>
+    void remove_from_zones(uint32_t row, uint32_t last) noexcept {
+        auto &zones = zone_of<T>();
+        auto &col = raw_column<T>();
+        zones.remove(row, col.get_unchecked(row));
+        if (row != last) {
+            zones.widen(row, col.get_unchecked(last));
+            zones.remove(last, col.get_unchecked(last));
+        }
+    }
+
+    void touch_row(uint32_t row) noexcept {
+        if (tracked_ != 0) {
+            ++version_;
+            for (auto &changes : changes_) {
+                changes.mark(row, version_);
+            }
+        }
+    }
+
+    template <class T>
+    void touch(uint32_t row) noexcept {
+        if (tracked_ != 0) {
+            changes_[IndexOf<T, Ts...>].mark(row, ++version_);
+        }
+    }
+
+    template <class T>
+    void touch_all() noexcept {
+        if (tracked_ != 0) {
+            changes_[IndexOf<T, Ts...>].mark_all(count(), ++version_);
+        }
+    }
+
     void destroy() {
         (..., raw_column<Ts>().destroy(index_.count()));
         index_.destroy();
@@ -119,5 +726,21 @@ private:
 private:
     Index index_;
     std::tuple<ThinVector<Ts>...> columns_;
+    std::array<ChangeTracker, sizeof...(Ts)> changes_;
+    uint64_t version_ = 0;
+    uint32_t tracked_ = 0;  // columns with enabled ChangeTracker
+    std::tuple<Aggregate<Ts>...> aggregates_;  // recomputed lazily on read
+    uint32_t aggregated_ = 0;                  // columns with enabled Aggregate
+    std::tuple<ZoneMap<Ts>...> zones_;         // dirty zones recomputed by refresh_zones()
+    uint32_t zoned_ = 0;                       // columns with enabled ZoneMap
+    ShrinkPolicy shrink_policy_;
+    uint32_t shrink_check_at_ = UINT32_MAX;  // count at which maybe_shrink() tries again
+    [[no_unique_address]] StatsRecorder stats_;
 };
+
+template <class... Ts>
+using Table = BasicTable<WideIdPolicy, Ts...>;
+
+template <class... Ts>
+using CompactTable = BasicTable<CompactIdPolicy, Ts...>;
 }  // namespace tablez::dense
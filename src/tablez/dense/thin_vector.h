@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
@@ -7,12 +9,17 @@
 #include <type_traits>
 #include <utility>
 
+#include "tablez/optional.h"
+#include "tablez/util.h"
+
 namespace tablez::dense {
 
 template <class T>
 class ThinVector {
     using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
 public:
+    using value_type = T;
+
     template <class U>
         requires(std::is_constructible_v<T, U &&>)
     void insert_at(uint32_t idx, U&& arg) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
@@ -23,19 +30,23 @@ public:
                    uint32_t last) noexcept(std::is_nothrow_destructible_v<T> && std::is_nothrow_move_assignable_v<T>) {
         assert(idx <= last);
 
-        data_[idx] = std::move(data_[last]);
+        if (idx != last) {
+            get_unchecked(idx) = std::move(get_unchecked(last));
+        }
         if constexpr (!std::is_trivially_destructible_v<T>) {
             get_unchecked(last).~T();
         }
     }
 
     void realloc(uint32_t new_capacity, uint32_t count) {
-        assert(count < new_capacity);
+        assert(count <= new_capacity);
 
         Storage * new_data = new Storage[new_capacity];
         if constexpr (std::is_trivially_copyable_v<T>) {
             static_assert(std::is_trivially_destructible_v<T>);
-            memcpy(new_data, data_, sizeof(Storage) * count);
+            if (count != 0) {
+                memcpy(new_data, data_, sizeof(Storage) * count);
+            }
         } else {
             for (uint32_t i = 0; i < count; ++i) {
                 auto &elem = get_unchecked(i);
@@ -49,6 +60,43 @@ public:
         data_ = new_data;
     }
 
+    // constructs [at, at + n) from copies of src values, with memcpy for trivially copyable T
+    void copy_in(uint32_t at, const T *src, uint32_t n) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n != 0) {
+                memcpy(data_ + at, src, sizeof(T) * n);
+            }
+        } else {
+            for (uint32_t i = 0; i < n; ++i) {
+                new (data_ + at + i) T(src[i]);
+            }
+        }
+    }
+
+    // same as copy_in, but moves src values, which still have to be destroyed
+    void move_in(uint32_t at, T *src, uint32_t n) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n != 0) {
+                memcpy(data_ + at, src, sizeof(T) * n);
+            }
+        } else {
+            for (uint32_t i = 0; i < n; ++i) {
+                new (data_ + at + i) T(std::move(src[i]));
+            }
+        }
+    }
+
+    // same as above, from [from, from + n) of src
+    void copy_in(uint32_t at, const ThinVector &src, uint32_t from, uint32_t n) noexcept(
+        std::is_nothrow_copy_constructible_v<T>) {
+        copy_in(at, &src.get_unchecked(from), n);
+    }
+
+    void move_in(uint32_t at, ThinVector &src, uint32_t from, uint32_t n) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        move_in(at, &src.get_unchecked(from), n);
+    }
+
     void destroy(uint32_t count) noexcept {
         if constexpr (std::is_trivially_destructible_v<T>) {
             return;
@@ -59,13 +107,25 @@ public:
         }
     }
 
+    void destroy(uint32_t begin, uint32_t end) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (uint32_t i = begin; i < end; ++i) {
+                get_unchecked(i).~T();
+            }
+        }
+    }
+
     void dealloc() noexcept {
         delete[] data_;
         data_ = nullptr;
     }
 
     std::span<T> span(uint32_t count) const noexcept {
-        return std::span{data_, count};
+        return {reinterpret_cast<T *>(data_), count};
+    }
+
+    void prefetch(uint32_t idx) const noexcept {
+        tablez::prefetch(data_ + idx);
     }
 
     T &get_unchecked(uint32_t idx) const noexcept {
@@ -75,4 +135,162 @@ public:
 private:
     Storage* data_ = nullptr;
 };
+
+// values of Optional<T> column with a presence bit per row, only present ones are constructed. Bits of
+//   rows from count on are always clear
+template <class T>
+class ThinVector<Optional<T>> {
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    using value_type = T;
+
+    template <class U>
+        requires(std::is_constructible_v<Optional<T>, U &&>)
+    void insert_at(uint32_t idx, U &&arg) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<U>, std::nullopt_t>) {
+            clear_bit(idx);
+        } else if constexpr (std::is_base_of_v<std::optional<T>, std::remove_cvref_t<U>>) {
+            if (arg.has_value()) {
+                insert_at(idx, *std::forward<U>(arg));
+            } else {
+                clear_bit(idx);
+            }
+        } else {
+            new (data_ + idx) T(std::forward<U>(arg));
+            set_bit(idx);
+        }
+    }
+
+    // same as insert_at, but into a row in use
+    template <class U>
+        requires(std::is_constructible_v<Optional<T>, U &&>)
+    void assign_at(uint32_t idx, U &&arg) {
+        if constexpr (std::is_constructible_v<T, U &&>) {
+            if (has(idx)) {
+                get_unchecked(idx) = std::forward<U>(arg);
+                return;
+            }
+        }
+        reset_at(idx);
+        insert_at(idx, std::forward<U>(arg));
+    }
+
+    void remove_at(uint32_t idx, uint32_t last) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                        std::is_nothrow_move_assignable_v<T>) {
+        assert(idx <= last);
+        if (idx != last) {
+            if (!has(last)) {
+                reset_at(idx);
+            } else if (has(idx)) {
+                get_unchecked(idx) = std::move(get_unchecked(last));
+            } else {
+                insert_at(idx, std::move(get_unchecked(last)));
+            }
+        }
+        reset_at(last);
+    }
+
+    void realloc(uint32_t new_capacity, uint32_t count) {
+        assert(count <= new_capacity);
+        Storage *new_data = new Storage[new_capacity];
+        uint64_t *new_bits = new uint64_t[words_for(new_capacity)]{};
+        for_each_present(count, [&](uint32_t idx) {
+            new (new_data + idx) T(std::move(get_unchecked(idx)));
+            get_unchecked(idx).~T();
+        });
+        std::copy_n(bits_, words_for(count), new_bits);
+        delete[] data_;
+        delete[] bits_;
+        data_ = new_data;
+        bits_ = new_bits;
+    }
+
+    // presence bits are written one by one, thus concurrent copies into one vector must not share words
+    void copy_in(uint32_t at, const ThinVector &src, uint32_t from, uint32_t n) noexcept(
+        std::is_nothrow_copy_constructible_v<T>) {
+        for (uint32_t i = 0; i < n; ++i) {
+            if (src.has(from + i)) {
+                insert_at(at + i, std::as_const(src.get_unchecked(from + i)));
+            } else {
+                clear_bit(at + i);
+            }
+        }
+    }
+
+    // src values get moved from, but still have to be destroyed
+    void move_in(uint32_t at, ThinVector &src, uint32_t from, uint32_t n) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        for (uint32_t i = 0; i < n; ++i) {
+            if (src.has(from + i)) {
+                insert_at(at + i, std::move(src.get_unchecked(from + i)));
+            } else {
+                clear_bit(at + i);
+            }
+        }
+    }
+
+    void destroy(uint32_t count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for_each_present(count, [&](uint32_t idx) { get_unchecked(idx).~T(); });
+        }
+        std::fill_n(bits_, words_for(count), 0);
+    }
+
+    void destroy(uint32_t begin, uint32_t end) noexcept {
+        for (uint32_t i = begin; i < end; ++i) {
+            reset_at(i);
+        }
+    }
+
+    void dealloc() noexcept {
+        delete[] data_;
+        delete[] bits_;
+        data_ = nullptr;
+        bits_ = nullptr;
+    }
+
+    bool has(uint32_t idx) const noexcept { return bits_[idx / 64] >> (idx % 64) & 1; }
+
+    // calls func(idx) for every present value of [0, count), skipping absent ones word by word
+    template <class Func>
+    void for_each_present(uint32_t count, Func &&func) const {
+        for (uint32_t word = 0; word < words_for(count); ++word) {
+            for (uint64_t bits = bits_[word]; bits != 0; bits &= bits - 1) {
+                func(word * 64 + std::countr_zero(bits));
+            }
+        }
+    }
+
+    uint32_t count_present(uint32_t count) const noexcept {
+        uint32_t present = 0;
+        for (uint32_t word = 0; word < words_for(count); ++word) {
+            present += std::popcount(bits_[word]);
+        }
+        return present;
+    }
+
+    void prefetch(uint32_t idx) const noexcept { tablez::prefetch(data_ + idx); }
+
+    // value must be present
+    T &get_unchecked(uint32_t idx) const noexcept { return reinterpret_cast<T &>(data_[idx]); }
+
+private:
+    static uint32_t words_for(uint32_t count) noexcept { return (uint64_t{count} + 63) / 64; }
+
+    void set_bit(uint32_t idx) noexcept { bits_[idx / 64] |= uint64_t{1} << (idx % 64); }
+
+    void clear_bit(uint32_t idx) noexcept { bits_[idx / 64] &= ~(uint64_t{1} << (idx % 64)); }
+
+    void reset_at(uint32_t idx) noexcept {
+        if (has(idx)) {
+            get_unchecked(idx).~T();
+            clear_bit(idx);
+        }
+    }
+
+private:
+    Storage *data_ = nullptr;
+    uint64_t *bits_ = nullptr;
+};
 }  // namespace tablez::dense
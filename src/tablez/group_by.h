@@ -0,0 +1,216 @@
+#pragma once
+
+#include <tablez/aggregate.h>
+#include <tablez/query.h>
+#include <tablez/util.h>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace tablez {
+
+template <class Key>
+concept GroupKey =
+    std::copyable<Key> && std::default_initializable<Key> && std::equality_comparable<Key> && requires(const Key &key) {
+        { std::hash<Key>{}(key) } -> std::convertible_to<size_t>;
+    };
+
+template <class Key, Aggregatable Value>
+struct Group {
+    using Sum = typename Aggregate<Value>::Sum;
+
+    Key key;
+    uint64_t count = 0;
+    Sum sum = 0;
+    Value min = 0;
+    Value max = 0;
+
+    void add(const Value &value) noexcept {
+        min = count == 0 ? value : std::min(min, value);
+        max = count == 0 ? value : std::max(max, value);
+        ++count;
+        sum += value;
+    }
+
+    void merge(const Group &rhs) noexcept {
+        min = count == 0 ? rhs.min : std::min(min, rhs.min);
+        max = count == 0 ? rhs.max : std::max(max, rhs.max);
+        count += rhs.count;
+        sum += rhs.sum;
+    }
+};
+
+namespace detail {
+
+// open addressing with linear probing, groups are stored right in slots, so a lookup touches one cache line
+template <class Key, class Value>
+class GroupTable {
+public:
+    using Group = tablez::Group<Key, Value>;
+
+    struct Entry {
+        uint64_t hash = 0;  // 0 for empty slot
+        Group group;
+    };
+
+    explicit GroupTable(uint32_t expected = 0) {
+        entries_.resize(std::bit_ceil(std::max<uint64_t>(16, uint64_t{expected} * 4 / 3 + 1)));
+    }
+
+    // hash must be non-zero, see slot_hash()
+    Group &find_or_add(const Key &key, uint64_t hash) {
+        if ((size_ + 1) * 4 > entries_.size() * 3) {  // load factor 0.75
+            rehash(entries_.size() * 2);
+        }
+        uint64_t mask = entries_.size() - 1;
+        for (uint64_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            auto &entry = entries_[slot];
+            if (entry.hash == 0) {
+                entry.hash = hash;
+                entry.group.key = key;
+                ++size_;
+                return entry.group;
+            }
+            if (entry.hash == hash && entry.group.key == key) {
+                return entry.group;
+            }
+        }
+    }
+
+    void prefetch(uint64_t hash) const noexcept { tablez::prefetch(&entries_[hash & (entries_.size() - 1)]); }
+
+    std::span<Entry> entries() noexcept { return entries_; }
+
+    std::vector<Group> take_groups() {
+        std::vector<Group> groups;
+        groups.reserve(size_);
+        for (auto &entry : entries_) {
+            if (entry.hash != 0) {
+                groups.push_back(std::move(entry.group));
+            }
+        }
+        return groups;
+    }
+
+private:
+    void rehash(uint64_t capacity) {
+        std::vector<Entry> old(capacity);
+        std::swap(old, entries_);
+        uint64_t mask = capacity - 1;
+        for (auto &entry : old) {
+            if (entry.hash != 0) {
+                uint64_t slot = entry.hash & mask;
+                while (entries_[slot].hash != 0) {
+                    slot = (slot + 1) & mask;
+                }
+                entries_[slot] = std::move(entry);
+            }
+        }
+    }
+
+private:
+    std::vector<Entry> entries_;
+    uint64_t size_ = 0;
+};
+
+// std::hash of integers is identity, which clusters in a power of two table. 0 is reserved for empty slot
+template <class Key>
+uint64_t slot_hash(const Key &key) noexcept {
+    uint64_t hash = std::hash<Key>{}(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash | (hash == 0);
+}
+
+// aggregates alive rows of [begin, end) into table chosen by table_of(hash), slot of each row gets
+//   prefetched PREFETCH_DISTANCE rows ahead
+template <class Source, class Key, class Value, class TableOf>
+void aggregate_rows(const Source &source, const Key *keys, const Value *values, uint32_t begin, uint32_t end,
+                    TableOf &&table_of) {
+    uint64_t hashes[PREFETCH_DISTANCE];
+    auto hash_ahead = [&](uint32_t row) {
+        if (row < end && source.alive(row)) {
+            uint64_t hash = slot_hash(keys[row]);
+            table_of(hash).prefetch(hash);
+            hashes[row % PREFETCH_DISTANCE] = hash;
+        }
+    };
+    for (uint32_t row = begin; row < std::min(end, begin + PREFETCH_DISTANCE); ++row) {
+        hash_ahead(row);
+    }
+    for (uint32_t row = begin; row < end; ++row) {
+        if (source.alive(row)) {
+            uint64_t hash = hashes[row % PREFETCH_DISTANCE];
+            table_of(hash).find_or_add(keys[row], hash).add(values[row]);
+        }
+        hash_ahead(row + PREFETCH_DISTANCE);
+    }
+}
+}  // namespace detail
+
+// groups alive rows of table by column Key and aggregates column Value of every group, order of groups
+//   is unspecified. With several threads each one aggregates its range of rows into a table per partition
+//   of key hashes, then each thread merges one partition of all the others. expected_groups presizes
+//   hash tables, guessed from count() if 0
+template <GroupKey Key, Aggregatable Value, class Table>
+std::vector<Group<Key, Value>> group_by(const Table &table, uint32_t threads = 1, uint32_t expected_groups = 0) {
+    using GroupTable = detail::GroupTable<Key, Value>;
+    QuerySource<Table> source{table};
+    const Key *keys = source.template column<Key>();
+    const Value *values = source.template column<Value>();
+    uint32_t size = source.size();
+    threads = std::clamp<uint32_t>(threads, 1, std::max<uint32_t>(1, size / 4096));
+    if (expected_groups == 0) {
+        expected_groups = std::min<uint32_t>(table.count(), 1 << 16);
+    }
+
+    if (threads == 1) {
+        GroupTable groups{expected_groups};
+        detail::aggregate_rows(source, keys, values, 0, size, [&](uint64_t) -> GroupTable & { return groups; });
+        return groups.take_groups();
+    }
+
+    // [thread][partition], partition is taken from high bits, slot in table from low ones
+    auto partition_of = [threads](uint64_t hash) -> uint32_t { return (hash >> 32) % threads; };
+    std::vector<std::vector<GroupTable>> local(threads);
+    std::vector<std::vector<Group<Key, Value>>> merged(threads);
+    auto aggregate = [&](uint32_t t) {
+        local[t].assign(threads, GroupTable{expected_groups / threads});
+        detail::aggregate_rows(source, keys, values, uint64_t{size} * t / threads, uint64_t{size} * (t + 1) / threads,
+                               [&](uint64_t hash) -> GroupTable & { return local[t][partition_of(hash)]; });
+    };
+    auto merge = [&](uint32_t p) {
+        GroupTable &into = local[0][p];
+        for (uint32_t t = 1; t < threads; ++t) {
+            for (auto &entry : local[t][p].entries()) {
+                if (entry.hash != 0) {
+                    into.find_or_add(entry.group.key, entry.hash).merge(entry.group);
+                }
+            }
+        }
+        merged[p] = into.take_groups();
+    };
+    auto run = [&](auto &&step) {
+        parallel_chunks(threads, threads, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t t = begin; t < end; ++t) {
+                step(t);
+            }
+        });
+    };
+    run(aggregate);
+    run(merge);
+
+    std::vector<Group<Key, Value>> groups = std::move(merged[0]);
+    for (uint32_t p = 1; p < threads; ++p) {
+        groups.insert(groups.end(), merged[p].begin(), merged[p].end());
+    }
+    return groups;
+}
+}  // namespace tablez
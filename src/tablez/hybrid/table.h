@@ -0,0 +1,212 @@
+#pragma once
+
+#include <tablez/dense/table.h>
+#include <tablez/id.h>
+#include <tablez/sparse/table.h>
+#include <tablez/util.h>
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tablez::hybrid {
+
+enum class Layout {
+    Dense,   // rows packed, scans touch only alive rows, remove moves the last row
+    Sparse,  // rows stay in their slots, remove moves nothing, scans walk the whole capacity
+};
+
+// when to switch layouts, checked once per window of inserts and removes. Occupancy is count / capacity,
+//   keep dense_below_occupancy under sparse_min_occupancy, so the table doesn't switch back and forth
+struct MigrationPolicy {
+    uint32_t window = 1024;               // 0 disables automatic migration
+    double sparse_remove_rate = 0.4;      // dense goes sparse once removes make up more of the window
+    double sparse_min_occupancy = 0.5;    //   but only if occupancy is at least that
+    double dense_below_occupancy = 0.25;  // sparse goes dense once occupancy drops below
+};
+
+// table which holds either dense or sparse layout and migrates between them between operations.
+//   Both layouts share Id space, migration moves values and keeps generation of every slot, thus
+//   Ids stay valid across migrations. Pointers and references into the table don't
+template <class... Ts>
+class Table {
+    // sparse layout has no presence bits, migration would read absent values of Optional columns
+    static_assert((!IsOptional<Ts> && ...), "hybrid::Table doesn't support Optional columns");
+
+public:
+    using Id = tablez::Id;
+    using Dense = dense::Table<Ts...>;
+    using Sparse = sparse::Table<Ts...>;
+
+    Table() noexcept = default;
+
+    explicit Table(Layout layout) {
+        if (layout == Layout::Sparse) {
+            table_.template emplace<Sparse>();
+        }
+    }
+
+    Layout layout() const noexcept { return std::holds_alternative<Dense>(table_) ? Layout::Dense : Layout::Sparse; }
+
+    void set_migration_policy(MigrationPolicy policy) noexcept {
+        policy_ = policy;
+        ops_ = 0;
+        removes_ = 0;
+    }
+
+    // moves all rows into the other layout, no-op if already there
+    void migrate(Layout to) {
+        if (to == layout()) {
+            return;
+        }
+        if (to == Layout::Sparse) {
+            table_ = to_sparse(std::get<Dense>(table_));
+        } else {
+            table_ = to_dense(std::get<Sparse>(table_));
+        }
+        ++migrations_;
+    }
+
+    uint32_t migrations() const noexcept { return migrations_; }
+
+    template <class... Us>
+        requires(std::is_constructible_v<Ts, Us &&> && ...)
+    Id insert(Us &&...args) {
+        Id id = std::visit([&](auto &table) { return table.insert(std::forward<Us>(args)...); }, table_);
+        count_op(false);
+        return id;
+    }
+
+    bool remove(Id id) {
+        if (!std::visit([id](auto &table) { return table.remove(id); }, table_)) {
+            return false;
+        }
+        count_op(true);
+        return true;
+    }
+
+    bool contains(Id id) const noexcept {
+        return std::visit([id](auto &table) { return table.contains(id); }, table_);
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    T *try_get(Id id) noexcept {
+        return std::visit([id](auto &table) { return table.template try_get<T>(id); }, table_);
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    const T *try_get(Id id) const noexcept {
+        return std::visit([id](auto &table) { return table.template try_get<T>(id); }, table_);
+    }
+
+    template <class T, class U>
+        requires(IsUniqueAmong<T, Ts...> && std::is_assignable_v<T &, U &&>)
+    bool set(Id id, U &&value) noexcept(std::is_nothrow_assignable_v<T &, U &&>) {
+        return std::visit([&](auto &table) { return table.template set<T>(id, std::forward<U>(value)); }, table_);
+    }
+
+    template <class Func>
+        requires(std::is_invocable_r_v<void, Func, Id, Ts &...>)
+    void for_each_row(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, Ts &...>) {
+        std::visit([&](auto &table) { table.for_each_row(func); }, table_);
+    }
+
+    template <class T, class Func>
+        requires(IsUniqueAmong<T, Ts...> && std::is_invocable_r_v<void, Func, Id, T &>)
+    void for_each(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, T &>) {
+        if (auto *table = std::get_if<Dense>(&table_)) {
+            table->template for_each<T>(func);
+        } else {
+            std::get<Sparse>(table_).template column<T>().for_each(func);
+        }
+    }
+
+    uint32_t count() const noexcept {
+        return std::visit([](auto &table) { return table.count(); }, table_);
+    }
+
+    uint32_t capacity() const noexcept {
+        return std::visit([](auto &table) { return table.capacity(); }, table_);
+    }
+
+private:
+    // safe point: called after insert or remove has finished, nothing of the table is borrowed
+    void count_op(bool removed) {
+        if (policy_.window == 0) {
+            return;
+        }
+        removes_ += removed;
+        if (++ops_ < policy_.window) {
+            return;
+        }
+
+        double occupancy = capacity() == 0 ? 1.0 : double(count()) / capacity();
+        if (layout() == Layout::Dense) {
+            if (removes_ > policy_.window * policy_.sparse_remove_rate && occupancy >= policy_.sparse_min_occupancy) {
+                migrate(Layout::Sparse);
+            }
+        } else if (occupancy < policy_.dense_below_occupancy) {
+            migrate(Layout::Dense);
+        }
+        ops_ = 0;
+        removes_ = 0;
+    }
+
+    // row keeps its slot, generations of free slots carry over too
+    static Sparse to_sparse(Dense &from) {
+        auto slots = from.index_.slots();
+        std::vector<uint32_t> gens(slots.size());
+        for (Id id : slots) {
+            gens[id.idx()] = id.gen();
+        }
+
+        Sparse to = Sparse::with_capacity(slots.size());
+        to.index_.dealloc();
+        to.index_ = sparse::Index::from_gens(gens, from.index_.gen_floor());
+        for (uint32_t row = 0; row < from.count(); ++row) {
+            uint32_t slot = slots[row].idx();
+            (..., to.template raw_column<Ts>().init_at(
+                      slot, std::move(from.template raw_column<Ts>().get_unchecked(row))));
+        }
+        to.rebuild_free();
+        return to;  // moved-from values get destroyed with from
+    }
+
+    // alive slots become rows in slot order, followed by free slots
+    static Dense to_dense(Sparse &from) {
+        auto gens = from.index_.gens();
+        std::vector<Id> slots;
+        slots.reserve(gens.size());
+        for (uint32_t slot = 0; slot < gens.size(); ++slot) {
+            if (from.index_.is_set(slot)) {
+                slots.emplace_back(gens[slot], slot);
+            }
+        }
+        for (uint32_t slot = 0; slot < gens.size(); ++slot) {
+            if (!from.index_.is_set(slot)) {
+                slots.emplace_back(gens[slot], slot);
+            }
+        }
+
+        Dense to;
+        to.index_ = dense::Index::from_slots(slots, from.count(), from.index_.gen_floor());
+        (..., to.template raw_column<Ts>().realloc(slots.size(), 0));
+        for (uint32_t row = 0; row < from.count(); ++row) {
+            uint32_t slot = slots[row].idx();
+            (..., to.template raw_column<Ts>().insert_at(
+                      row, std::move(from.template raw_column<Ts>().assume_init_at(slot))));
+        }
+        return to;
+    }
+
+private:
+    std::variant<Dense, Sparse> table_;
+    MigrationPolicy policy_;
+    uint32_t ops_ = 0;      // inserts and removes in current window
+    uint32_t removes_ = 0;  // removes in current window
+    uint32_t migrations_ = 0;
+};
+}  // namespace tablez::hybrid
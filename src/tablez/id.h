@@ -2,39 +2,78 @@
 
 #include <cassert>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace tablez {
 
-class Id {
-    static constexpr uint64_t EMPTY_MASK = uint64_t{1} << 32;
+// how Id gets packed into Value: generation in the high GEN_BITS, slot in the rest. Gen is the type slot
+//   generations are stored in by indices. Generations wrap modulo 2^GEN_BITS, odd ones mark free slots
+struct WideIdPolicy {
+    using Value = uint64_t;
+    using Gen = uint32_t;
+    static constexpr uint32_t GEN_BITS = 32;
+};
+
+// up to 16M slots, a slot may be reused 128 times before its stale Ids become valid again
+struct CompactIdPolicy {
+    using Value = uint32_t;
+    using Gen = uint8_t;
+    static constexpr uint32_t GEN_BITS = 8;
+};
+
+template <class Policy>
+class BasicId {
+    using Value = typename Policy::Value;
+
 public:
+    using Gen = typename Policy::Gen;
+
+    static constexpr uint32_t GEN_BITS = Policy::GEN_BITS;
+    static constexpr uint32_t IDX_BITS = sizeof(Value) * 8 - GEN_BITS;
+    static constexpr uint32_t MAX_IDX = (Value{1} << IDX_BITS) - 1;
+    static constexpr uint32_t GEN_MASK = static_cast<uint32_t>((uint64_t{1} << GEN_BITS) - 1);
     static constexpr uint32_t EMPTY_GEN = 1;
 
-    Id() noexcept = default;
+    static_assert(GEN_BITS >= 2 && GEN_BITS <= sizeof(Gen) * 8 && IDX_BITS > 0 && IDX_BITS <= 32);
+
+private:
+    static constexpr Value EMPTY_MASK = Value{EMPTY_GEN} << IDX_BITS;
+
+public:
+    BasicId() noexcept = default;
 
-    Id(uint32_t gen, uint32_t idx) noexcept
-        : value_{(uint64_t{gen} << 32) | idx}
-    {}
+    BasicId(uint32_t gen, uint32_t idx) noexcept
+        : value_{static_cast<Value>((Value{gen & GEN_MASK} << IDX_BITS) | idx)}
+    {
+        assert(idx <= MAX_IDX);
+    }
 
-    static Id make_empty(uint32_t idx) noexcept {
-        return Id{EMPTY_MASK >> 32, idx};
+    static BasicId make_empty(uint32_t idx) noexcept {
+        return BasicId{EMPTY_GEN, idx};
+    }
+
+    // generation a slot gets after gen, wrapping around
+    static constexpr Gen next_gen(Gen gen) noexcept {
+        return static_cast<Gen>((gen + EMPTY_GEN) & GEN_MASK);
     }
 
     uint32_t idx() const noexcept {
-        return static_cast<uint32_t>(value_);
+        return static_cast<uint32_t>(value_ & MAX_IDX);
     }
 
     uint32_t gen() const noexcept {
-        return static_cast<uint32_t>(value_ >> 32);
+        return static_cast<uint32_t>(value_ >> IDX_BITS);
     }
 
-    Id &make_gen_valid() noexcept {
+    // generation is in the top bits, so it wraps around on overflow of value_
+    BasicId &make_gen_valid() noexcept {
         assert(is_empty());
         value_ += EMPTY_MASK;
         return *this;
     }
 
-    Id &make_gen_invalid() noexcept {
+    BasicId &make_gen_invalid() noexcept {
         assert(!is_empty());
         value_ += EMPTY_MASK;
         return *this;
@@ -43,11 +82,24 @@ public:
     bool is_empty() const noexcept {
         return value_ & EMPTY_MASK;
     }
+
+    bool operator==(const BasicId &) const noexcept = default;
 private:
-    uint64_t value_;
+    Value value_;
 };
 
+using Id = BasicId<WideIdPolicy>;
+using CompactId = BasicId<CompactIdPolicy>;
+
+static_assert(sizeof(Id) == 8 && sizeof(CompactId) == 4);
+
 template <class T>
 class TaggedId : Id {};
 
+// pairs of old and new Id of rows which got moved
+template <class Policy>
+using BasicIdRemap = std::vector<std::pair<BasicId<Policy>, BasicId<Policy>>>;
+
+using IdRemap = BasicIdRemap<WideIdPolicy>;
+
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tablez {
+
+// uninitialized storage for N values right inside its owner, owner tracks which ones are alive
+template <class T, uint32_t N>
+class InlineStorage {
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    T &at(uint32_t idx) noexcept {
+        assert(idx < N);
+        return *std::launder(reinterpret_cast<T *>(data_ + idx));
+    }
+
+    const T &at(uint32_t idx) const noexcept {
+        assert(idx < N);
+        return *std::launder(reinterpret_cast<const T *>(data_ + idx));
+    }
+
+    T *data() noexcept { return std::launder(reinterpret_cast<T *>(data_)); }
+
+    const T *data() const noexcept { return std::launder(reinterpret_cast<const T *>(data_)); }
+
+    template <class... Args>
+    T &init_at(uint32_t idx, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>) {
+        assert(idx < N);
+        return *(new (data_ + idx) T(std::forward<Args>(args)...));
+    }
+
+    void destroy_at(uint32_t idx) noexcept(std::is_nothrow_destructible_v<T>) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            at(idx).~T();
+        }
+    }
+
+private:
+    Storage data_[N];
+};
+}  // namespace tablez
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <optional>
+#include <type_traits>
+
+namespace tablez {
+
+// column of T which rows may have no value in, e.g. dense::Table<int, Optional<double>>. Table keeps a
+//   presence bit per row and constructs only present values. Values get passed in as T, Optional<T> or
+//   std::nullopt and handed out as T, absent ones get skipped
+template <class T>
+class Optional : public std::optional<T> {
+public:
+    using std::optional<T>::optional;
+};
+
+template <class T>
+inline constexpr bool IS_OPTIONAL = false;
+
+template <class T>
+inline constexpr bool IS_OPTIONAL<Optional<T>> = true;
+
+template <class T>
+concept IsOptional = IS_OPTIONAL<T>;
+
+namespace detail {
+template <class T>
+struct ColumnValue {
+    using type = T;
+};
+
+template <class T>
+struct ColumnValue<Optional<T>> {
+    using type = T;
+};
+}  // namespace detail
+
+// type of values column T hands out: U for Optional<U>, T otherwise
+template <class T>
+using ColumnValue = typename detail::ColumnValue<T>::type;
+}  // namespace tablez
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <tablez/aggregate.h>
+#include <tablez/dense/table.h>
+#include <tablez/id.h>
+#include <tablez/sparse/table.h>
+#include <tablez/util.h>
+#include <tablez/zone_map.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tablez {
+
+// row access of a table for Query: rows [0, size()), of which alive() ones get visited
+template <class Table>
+struct QuerySource;
+
+template <class Policy, class... Ts>
+struct QuerySource<dense::BasicTable<Policy, Ts...>> {
+    using Id = BasicId<Policy>;
+
+    const dense::BasicTable<Policy, Ts...> &table;
+
+    uint32_t size() const noexcept { return table.count(); }
+
+    constexpr bool alive(uint32_t) const noexcept { return true; }
+
+    Id id(uint32_t row) const noexcept { return table.ids()[row]; }
+
+    template <class T>
+    const T *column() const noexcept {
+        return table.template values<T>().data();
+    }
+
+    // zones of column T, nullptr if they aren't tracked. Dirty ones don't get skipped
+    template <class T>
+    const ZoneMap<T> *zones() const noexcept {
+        if constexpr (Aggregatable<T>) {
+            return table.template zone_map<T>();
+        } else {
+            return nullptr;
+        }
+    }
+};
+
+template <class Policy, class... Ts>
+struct QuerySource<sparse::BasicTable<Policy, Ts...>> {
+    using Id = BasicId<Policy>;
+
+    const sparse::BasicTable<Policy, Ts...> &table;
+
+    uint32_t size() const noexcept { return table.capacity(); }
+
+    bool alive(uint32_t slot) const noexcept { return table.index_.is_set(slot); }
+
+    Id id(uint32_t slot) const noexcept { return table.index_.get_unchecked(slot); }
+
+    // values at free slots aren't initialized
+    template <class T>
+    const T *column() const noexcept {
+        return size() == 0 ? nullptr : &table.template raw_column<T>().assume_init_at(0);
+    }
+
+    template <class T>
+    const ZoneMap<T> *zones() const noexcept {
+        return nullptr;
+    }
+};
+
+template <class Pred>
+concept QueryPredicate = Pred::IS_PREDICATE;
+
+template <class Op, class V>
+struct Compare {
+    static constexpr bool IS_PREDICATE = true;
+    V value;
+
+    template <class T>
+    bool operator()(const T &arg) const noexcept {
+        return Op{}(arg, value);
+    }
+
+    // whether any value in [lo, hi] may pass
+    template <class T>
+    bool may_match(const T &lo, const T &hi) const noexcept {
+        if constexpr (std::is_same_v<Op, std::less<>> || std::is_same_v<Op, std::less_equal<>>) {
+            return Op{}(lo, value);
+        } else if constexpr (std::is_same_v<Op, std::greater<>> || std::is_same_v<Op, std::greater_equal<>>) {
+            return Op{}(hi, value);
+        } else if constexpr (std::is_same_v<Op, std::equal_to<>>) {
+            return lo <= value && hi >= value;
+        } else if constexpr (std::is_same_v<Op, std::not_equal_to<>>) {
+            return lo != value || hi != value;
+        } else {
+            return true;
+        }
+    }
+};
+
+// combine with & and |: both sides get evaluated, no branch
+template <class Op, QueryPredicate L, QueryPredicate R>
+struct Combine {
+    static constexpr bool IS_PREDICATE = true;
+    L lhs;
+    R rhs;
+
+    template <class T>
+    bool operator()(const T &arg) const noexcept {
+        return Op{}(lhs(arg), rhs(arg));
+    }
+
+    template <class T>
+    bool may_match(const T &lo, const T &hi) const noexcept {
+        return Op{}(lhs.may_match(lo, hi), rhs.may_match(lo, hi));
+    }
+};
+
+// stands for column value in where(), e.g. where<double>(_ > 0.5 && _ < 1.0)
+struct Placeholder {};
+inline constexpr Placeholder _{};
+
+template <class V>
+Compare<std::less<>, V> operator<(Placeholder, V value) noexcept {
+    return {value};
+}
+
+template <class V>
+Compare<std::less_equal<>, V> operator<=(Placeholder, V value) noexcept {
+    return {value};
+}
+
+template <class V>
+Compare<std::greater<>, V> operator>(Placeholder, V value) noexcept {
+    return {value};
+}
+
+template <class V>
+Compare<std::greater_equal<>, V> operator>=(Placeholder, V value) noexcept {
+    return {value};
+}
+
+template <class V>
+Compare<std::equal_to<>, V> operator==(Placeholder, V value) noexcept {
+    return {value};
+}
+
+template <class V>
+Compare<std::not_equal_to<>, V> operator!=(Placeholder, V value) noexcept {
+    return {value};
+}
+
+template <QueryPredicate L, QueryPredicate R>
+Combine<std::bit_and<>, L, R> operator&&(L lhs, R rhs) noexcept {
+    return {lhs, rhs};
+}
+
+template <QueryPredicate L, QueryPredicate R>
+Combine<std::bit_or<>, L, R> operator||(L lhs, R rhs) noexcept {
+    return {lhs, rhs};
+}
+
+namespace detail {
+
+template <class T, class Pred>
+struct Filter {
+    Pred pred;
+
+    // predicate over rows of source, column pointer resolved once
+    template <class Source>
+    auto bind(const Source &source) const noexcept {
+        return [pred = pred, data = source.template column<T>()](uint32_t row) { return pred(data[row]); };
+    }
+
+    // whether any row of a zone may pass, true when column T has no zones
+    template <class Source>
+    auto bind_zones(const Source &source) const {
+        return [pred = pred, zones = source.template zones<T>()](uint32_t zone) {
+            return zones == nullptr || zones->may_match(zone, pred);
+        };
+    }
+};
+}  // namespace detail
+
+// lazy pipeline over one table: where() filters, select() picks columns, terminal operation runs all
+//   of them in a single pass over rows. Filters of a row get combined without branches, thus the loop over
+//   dense table may get vectorized. Zones of ZONE_ROWS rows which a filter on a column with tracked zones
+//   rules out get skipped whole, zones dirty since the last refresh_zones() of the table get scanned
+template <class Source, class Filters, class... Selected>
+class Query {
+    using Id = typename Source::Id;
+
+public:
+    Query(Source source, Filters filters) : source_{source}, filters_{std::move(filters)} {}
+
+    template <class T, QueryPredicate Pred>
+    auto where(Pred pred) const {
+        auto filters = std::tuple_cat(filters_, std::tuple{detail::Filter<T, Pred>{pred}});
+        return Query<Source, decltype(filters), Selected...>{source_, std::move(filters)};
+    }
+
+    template <class... Us>
+    auto select() const {
+        return Query<Source, Filters, Us...>{source_, filters_};
+    }
+
+    uint32_t count() const noexcept {
+        uint32_t count = 0;
+        run([&](uint32_t, bool keep) { count += keep; });
+        return count;
+    }
+
+    auto sum() const noexcept
+        requires(sizeof...(Selected) == 1 && (Aggregatable<Selected> && ...))
+    {
+        using T = std::tuple_element_t<0, std::tuple<Selected...>>;
+        typename Aggregate<T>::Sum sum = 0;
+        const T *data = source_.template column<T>();
+        run([&](uint32_t row, bool keep) {
+            if (keep) {
+                sum += data[row];
+            }
+        });
+        return sum;
+    }
+
+    template <class Func>
+        requires(std::is_invocable_r_v<void, Func, Id, const Selected &...>)
+    void for_each(Func &&func) const {
+        std::tuple<const Selected *...> columns{source_.template column<Selected>()...};
+        run([&](uint32_t row, bool keep) {
+            if (keep) {
+                func(source_.id(row), std::get<const Selected *>(columns)[row]...);
+            }
+        });
+    }
+
+private:
+    // visits rows with whether they pass all filters, rows of skipped zones don't get visited
+    template <class Visit>
+    void run(Visit &&visit) const {
+        std::apply(
+            [&](auto &...filters) {
+                auto bound = std::tuple{filters.bind(source_)...};
+                auto zones = std::tuple{filters.bind_zones(source_)...};
+                uint32_t size = source_.size();
+                for (uint32_t zone = 0; zone < (uint64_t{size} + ZONE_ROWS - 1) >> ZONE_SHIFT; ++zone) {
+                    if (!std::apply([&](auto &...may_match) { return (true && ... && may_match(zone)); }, zones)) {
+                        continue;
+                    }
+                    uint32_t end = std::min<uint64_t>(size, uint64_t{zone + 1} << ZONE_SHIFT);
+                    for (uint32_t row = zone << ZONE_SHIFT; row < end; ++row) {
+                        // free slots of sparse table are never read, for dense alive() is always true
+                        bool keep = source_.alive(row) &&
+                                    std::apply([&](auto &...pred) { return (true & ... & pred(row)); }, bound);
+                        visit(row, keep);
+                    }
+                }
+            },
+            filters_);
+    }
+
+private:
+    Source source_;
+    Filters filters_;
+};
+
+template <class Table>
+auto from(const Table &table) {
+    return Query<QuerySource<Table>, std::tuple<>>{QuerySource<Table>{table}, {}};
+}
+}  // namespace tablez
@@ -2,9 +2,12 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 
+#include "tablez/util.h"
+
 namespace tablez::sparse {
 
 // owns nothing, doesn't know it's size
@@ -26,6 +29,8 @@ public:
 
     T &assume_init_at(uint32_t idx) const noexcept { return reinterpret_cast<T &>(data_[idx]); }
 
+    void prefetch(uint32_t idx) const noexcept { tablez::prefetch(data_ + idx); }
+
     template <class... Args>
     T &init_at(uint32_t idx, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>) {
         return *(new (data_ + idx) T(std::forward<Args>(args)...));
@@ -60,6 +65,44 @@ public:
         data_ = dst;
     }
 
+    // moves elements below new_capacity into smaller storage, there must be none above
+    template <class IsInit>
+        requires std::is_invocable_r_v<bool, IsInit, uint32_t>
+    void shrink_for_capacity(uint32_t new_capacity, IsInit is_init) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                                               std::is_nothrow_destructible_v<T>) {
+        auto dst = new Storage[new_capacity];
+        for (uint32_t i = 0; i < new_capacity; ++i) {
+            if (is_init(i)) {
+                auto &val = assume_init_at(i);
+                new (dst + i) T(std::move(val));
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    val.~T();
+                }
+            }
+        }
+        dealloc();
+        data_ = dst;
+    }
+
+    // copies initialized elements of src in [begin, end) into the same places, storage must be there already.
+    //   Trivially copyable ones get copied with memcpy, regardless of being initialized
+    template <class IsInit>
+        requires std::is_invocable_r_v<bool, IsInit, uint32_t>
+    void copy_in(const Blob &src, uint32_t begin, uint32_t end,
+                 IsInit is_init) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (begin != end) {
+                memcpy(data_ + begin, src.data_ + begin, sizeof(Storage) * (end - begin));
+            }
+        } else {
+            for (uint32_t i = begin; i < end; ++i) {
+                if (is_init(i)) {
+                    init_at(i, src.assume_init_at(i));
+                }
+            }
+        }
+    }
+
     template <class IsInit>
         requires std::is_invocable_r_v<bool, IsInit, uint32_t>
     void destroy(uint32_t capacity, IsInit is_init) noexcept(std::is_nothrow_destructible_v<T>) {
@@ -1,38 +1,63 @@
 #pragma once
 
 #include <tablez/id.h>
+#include <tablez/util.h>
 
 #include <algorithm>
 #include <cstdint>
-#include <limits>
 #include <ranges>
 #include <span>
 
 namespace tablez::sparse {
 
-class IndexIter;
+template <class Policy>
+class BasicIndexIter;
 class IndexIterEnd {};
 
 // doesn't necessarily own it's stuff
-class Index {
-    explicit Index(uint32_t capacity)
-        : gens_(new(std::align_val_t{32}) uint32_t[capacity]), capacity_(capacity), count_(0) {
+template <class Policy>
+class BasicIndex {
+    using Id = BasicId<Policy>;
+    using Gen = typename Id::Gen;
+    using IndexIter = BasicIndexIter<Policy>;
+
+    explicit BasicIndex(uint32_t capacity)
+        : gens_(new Gen[capacity]), capacity_(capacity), count_(0) {
         std::fill_n(gens_, capacity_, EMPTY_MASK);
     }
 
 public:
-    constexpr Index() noexcept = default;
+    constexpr BasicIndex() noexcept = default;
 
-    constexpr static uint32_t EMPTY_MASK = 1;
+    constexpr static Gen EMPTY_MASK = Id::EMPTY_GEN;
+    constexpr static size_t SLOT_BYTES = sizeof(Gen);  // memory taken by every slot
 
-    static Index with_capacity(uint32_t capacity) { return Index(capacity); }
+    static BasicIndex with_capacity(uint32_t capacity) { return BasicIndex(capacity); }
 
-    bool is_set(uint32_t idx) noexcept {
+    // takes generation of every slot, odd ones are free
+    static BasicIndex from_gens(std::span<const Gen> gens, Gen gen_floor = EMPTY_MASK) {
+        BasicIndex index(gens.size());
+        std::copy(gens.begin(), gens.end(), index.gens_);
+        index.count_ = std::count_if(gens.begin(), gens.end(), [](Gen gen) { return !(gen & EMPTY_MASK); });
+        index.gen_floor_ = gen_floor;
+        return index;
+    }
+
+    // deep copy, index doesn't free its storage by itself
+    BasicIndex clone() const {
+        BasicIndex index(capacity_);
+        std::copy_n(gens_, capacity_, index.gens_);
+        index.count_ = count_;
+        index.gen_floor_ = gen_floor_;
+        return index;
+    }
+
+    bool is_set(uint32_t idx) const noexcept {
         assert(idx < capacity_);
         return !(gens_[idx] & EMPTY_MASK);
     }
 
-    Id get_unchecked(uint32_t idx) noexcept {
+    Id get_unchecked(uint32_t idx) const noexcept {
         assert(idx < capacity_);
         assert(is_set(idx));
         return Id{gens_[idx], idx};
@@ -41,9 +66,8 @@ public:
     Id push_unchecked(uint32_t idx) noexcept {
         assert(idx < capacity_);
         assert(!is_set(idx));
-        assert(gens_[idx] < std::numeric_limits<uint32_t>::max());
 
-        uint32_t gen = ++gens_[idx];
+        Gen gen = gens_[idx] = Id::next_gen(gens_[idx]);
         ++count_;
         return Id{gen, idx};
     }
@@ -51,7 +75,8 @@ public:
     bool try_remove(Id id) noexcept {
         assert(id.idx() < capacity());
         assert(!id.is_empty());
-        if (id.gen() == gens_[id.idx()]++) {  // invalidate
+        if (id.gen() == gens_[id.idx()]) {
+            gens_[id.idx()] = Id::next_gen(gens_[id.idx()]);  // invalidate
             assert(count_ > 0);
             --count_;
             return true;
@@ -59,21 +84,40 @@ public:
         return false;
     }
 
+    void prefetch(uint32_t idx) const noexcept { tablez::prefetch(gens_ + idx); }
+
     uint32_t capacity() const noexcept { return capacity_; }
 
     uint32_t count() const noexcept { return count_; }
 
+    Gen gen_floor() const noexcept { return gen_floor_; }
+
+    std::span<const Gen> gens() const noexcept { return {gens_, capacity_}; }
+
+    // bit per slot of [64 * word, 64 * word + 64), set for occupied ones
+    uint64_t occupancy_word(uint32_t word) const noexcept {
+        uint32_t begin = word * 64;
+        uint32_t end = std::min(begin + 64, capacity_);
+        uint64_t bits = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            bits |= uint64_t{!(gens_[i] & EMPTY_MASK)} << (i - begin);
+        }
+        return bits;
+    }
+
     void dealloc() noexcept {
         if (gens_) {
             delete[] gens_;
             gens_ = nullptr;
         }
+        capacity_ = 0;
+        count_ = 0;
     }
 
     auto set_range() const noexcept {
-        return std::span<uint32_t>{gens_, capacity_} |
-               std::ranges::views::filter([](uint32_t gen) { return !(gen & EMPTY_MASK); }) |
-               std::ranges::views::transform([base = gens_](const uint32_t &gen) {
+        return std::span<Gen>{gens_, capacity_} |
+               std::ranges::views::filter([](Gen gen) { return !(gen & EMPTY_MASK); }) |
+               std::ranges::views::transform([base = gens_](const Gen &gen) {
                    uint32_t offset = (&gen - base);
                    return Id{gen, offset};
                });
@@ -81,18 +125,33 @@ public:
 
     void reserve_at_least(uint32_t new_capacity) {
         assert(new_capacity >= capacity_);
-        auto *new_gens = new uint32_t[new_capacity];
+        auto *new_gens = new Gen[new_capacity];
         for (uint32_t i = 0; i < capacity_; ++i) {
             new_gens[i] = gens_[i];
         }
         for (uint32_t i = capacity_; i < new_capacity; ++i) {
-            new_gens[i] = EMPTY_MASK;
+            new_gens[i] = gen_floor_;
         }
         delete[] gens_;
         gens_ = new_gens;
         capacity_ = new_capacity;
     }
 
+    // drops slots from new_capacity on, they must be free. Their generations are kept as a floor
+    //   for slots added later, so their stale Ids stay invalid
+    void shrink_to(uint32_t new_capacity) {
+        assert(new_capacity <= capacity_);
+        for (uint32_t i = new_capacity; i < capacity_; ++i) {
+            assert(!is_set(i));
+            gen_floor_ = std::max(gen_floor_, gens_[i]);
+        }
+        auto *new_gens = new Gen[new_capacity];
+        std::copy_n(gens_, new_capacity, new_gens);
+        delete[] gens_;
+        gens_ = new_gens;
+        capacity_ = new_capacity;
+    }
+
     IndexIter begin() const noexcept;
     IndexIterEnd end() const noexcept;
 
@@ -108,15 +167,22 @@ public:
     }
 
 private:
-    uint32_t *gens_ = nullptr;
+    Gen *gens_ = nullptr;
     uint32_t capacity_ = 0;
     uint32_t count_ = 0;
+    Gen gen_floor_ = EMPTY_MASK;  // the highest generation of slots dropped by shrink_to()
 };
 
-class IndexIter {
-    friend class Index;
+template <class Policy>
+class BasicIndexIter {
+    using Id = BasicId<Policy>;
+    using Gen = typename Id::Gen;
+    using Index = BasicIndex<Policy>;
+    using IndexIter = BasicIndexIter;
 
-    IndexIter(uint32_t *base, uint32_t capacity) : gen_base_{base}, gen_size_{capacity}, curr_{0} {
+    friend class BasicIndex<Policy>;
+
+    BasicIndexIter(Gen *base, uint32_t capacity) : gen_base_{base}, gen_size_{capacity}, curr_{0} {
         while (curr_ < gen_size_ && (gen_ = gen_base_[curr_]) & Index::EMPTY_MASK) {
             curr_++;
         }
@@ -178,15 +244,25 @@ public:
     }
 
 private:
-    uint32_t *gen_base_ = nullptr;
+    Gen *gen_base_ = nullptr;
     uint32_t gen_size_ = 0;
     uint32_t curr_ = 0;
-    uint32_t gen_ = 0;
+    Gen gen_ = 0;
 };
 
-inline IndexIter Index::begin() const noexcept { return IndexIter{gens_, capacity_}; }
+template <class Policy>
+BasicIndexIter<Policy> BasicIndex<Policy>::begin() const noexcept {
+    return IndexIter{gens_, capacity_};
+}
+
+template <class Policy>
+IndexIterEnd BasicIndex<Policy>::end() const noexcept {
+    return IndexIterEnd{};
+}
 
-inline IndexIterEnd Index::end() const noexcept { return IndexIterEnd{}; }
+using Index = BasicIndex<WideIdPolicy>;
+using IndexIter = BasicIndexIter<WideIdPolicy>;
+using CompactIndex = BasicIndex<CompactIdPolicy>;
 
-static_assert(std::ranges::range<Index>);
+static_assert(std::ranges::range<Index> && std::ranges::range<CompactIndex>);
 }  // namespace tablez::sparse
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <tablez/id.h>
+#include <tablez/inline_storage.h>
+#include <tablez/util.h>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tablez::sparse {
+
+// Table of at most N slots with generations, free slots and columns stored inline, makes no allocations,
+//   thus may live on stack, inside other objects or in shared memory. Slots are visited in a loop of N
+//   iterations. Has no change tracking, aggregates, slot policies or shrinking
+template <uint32_t N, class... Ts>
+    requires(N > 0)
+class StaticTable {
+public:
+    static constexpr uint32_t CAPACITY = N;
+
+    StaticTable() noexcept { reset_slots(); }
+
+    StaticTable(const StaticTable &rhs) noexcept((std::is_nothrow_copy_constructible_v<Ts> && ...))
+        requires(std::is_copy_constructible_v<Ts> && ...)
+        : StaticTable() {
+        assign_from(rhs);
+    }
+
+    StaticTable(StaticTable &&rhs) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...)) : StaticTable() {
+        assign_from(rhs);
+    }
+
+    // copy and move: *this stays as it was if a copy throws
+    StaticTable &operator=(const StaticTable &rhs) requires(std::is_copy_constructible_v<Ts> && ...)
+    {
+        if (this != &rhs) {
+            StaticTable copy(rhs);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    // *this is left empty if a move throws
+    StaticTable &operator=(StaticTable &&rhs) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...)) {
+        if (this != &rhs) {
+            destroy();
+            reset_slots();
+            assign_from(rhs);
+        }
+        return *this;
+    }
+
+    ~StaticTable() noexcept { destroy(); }
+
+    // table must not be full(). Last freed slot gets reused first
+    template <class... Us>
+        requires(std::is_constructible_v<Ts, Us &&> && ...)
+    Id insert(Us &&...args) noexcept((std::is_nothrow_constructible_v<Ts, Us> && ...)) {
+        assert(!full());
+        uint32_t slot = free_[count_++];
+        gens_[slot] = Id::next_gen(gens_[slot]);
+        (..., raw_column<Ts>().init_at(slot, std::forward<Us>(args)));
+        return Id{gens_[slot], slot};
+    }
+
+    bool remove(Id id) noexcept((std::is_nothrow_destructible_v<Ts> && ...)) {
+        if (!contains(id)) {
+            return false;
+        }
+        uint32_t slot = id.idx();
+        gens_[slot] = Id::next_gen(gens_[slot]);
+        free_[--count_] = slot;
+        (..., raw_column<Ts>().destroy_at(slot));
+        return true;
+    }
+
+    bool contains(Id id) const noexcept { return id.idx() < N && gens_[id.idx()] == id.gen(); }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    T *try_get(Id id) noexcept {
+        return contains(id) ? &raw_column<T>().at(id.idx()) : nullptr;
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    const T *try_get(Id id) const noexcept {
+        return contains(id) ? &raw_column<T>().at(id.idx()) : nullptr;
+    }
+
+    template <class T, class U>
+        requires(IsUniqueAmong<T, Ts...> && std::is_assignable_v<T &, U &&>)
+    bool set(Id id, U &&value) noexcept(std::is_nothrow_assignable_v<T &, U &&>) {
+        T *at = try_get<T>(id);
+        if (at == nullptr) {
+            return false;
+        }
+        *at = std::forward<U>(value);
+        return true;
+    }
+
+    template <class Func>
+        requires(std::is_invocable_r_v<void, Func, Id, Ts &...>)
+    void for_each_row(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, Ts &...>) {
+        std::tuple<Ts *...> columns{raw_column<Ts>().data()...};
+        for (uint32_t slot = 0; slot < N; ++slot) {
+            if (is_set(slot)) {
+                func(Id{gens_[slot], slot}, std::get<Ts *>(columns)[slot]...);
+            }
+        }
+    }
+
+    template <class T, class Func>
+        requires(std::is_invocable_r_v<void, Func, Id, T &>)
+    void for_each(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, T &>) {
+        T *values = raw_column<T>().data();
+        for (uint32_t slot = 0; slot < N; ++slot) {
+            if (is_set(slot)) {
+                func(Id{gens_[slot], slot}, values[slot]);
+            }
+        }
+    }
+
+    void clear() noexcept {
+        destroy();
+        for (uint32_t slot = 0; slot < N; ++slot) {
+            if (is_set(slot)) {
+                gens_[slot] = Id::next_gen(gens_[slot]);
+            }
+            free_[slot] = slot;
+        }
+        count_ = 0;
+    }
+
+    uint32_t count() const noexcept { return count_; }
+
+    static constexpr uint32_t capacity() noexcept { return N; }
+
+    bool full() const noexcept { return count_ == N; }
+
+private:
+    bool is_set(uint32_t slot) const noexcept { return !(gens_[slot] & Id::EMPTY_GEN); }
+
+    void destroy() noexcept {
+        if constexpr (!(std::is_trivially_destructible_v<Ts> && ...)) {
+            for (uint32_t slot = 0; slot < N; ++slot) {
+                if (is_set(slot)) {
+                    (..., raw_column<Ts>().destroy_at(slot));
+                }
+            }
+        }
+    }
+
+    void reset_slots() noexcept {
+        gens_.fill(Id::EMPTY_GEN);
+        for (uint32_t i = 0; i < N; ++i) {
+            free_[i] = i;
+        }
+        count_ = 0;
+    }
+
+    // *this must have no rows. Copies rows of const rhs, moves them otherwise. Takes slots after all
+    //   values got constructed, thus stays empty on throw
+    template <class Rhs>
+    void assign_from(Rhs &rhs) {
+        init_columns<0>(rhs);
+        gens_ = rhs.gens_;
+        free_ = rhs.free_;
+        count_ = rhs.count_;
+    }
+
+    // constructs column I and the ones after it, if any value throws, values constructed so far get destroyed
+    template <size_t I, class Rhs>
+    void init_columns(Rhs &rhs) {
+        if constexpr (I < sizeof...(Ts)) {
+            auto &col = std::get<I>(columns_);
+            auto &from = std::get<I>(rhs.columns_);
+            uint32_t slot = 0;
+            try {
+                for (; slot < N; ++slot) {
+                    if (!rhs.is_set(slot)) {
+                        continue;
+                    }
+                    if constexpr (std::is_const_v<Rhs>) {
+                        col.init_at(slot, from.at(slot));
+                    } else {
+                        col.init_at(slot, std::move(from.at(slot)));
+                    }
+                }
+                init_columns<I + 1>(rhs);
+            } catch (...) {
+                for (uint32_t at = 0; at < slot; ++at) {
+                    if (rhs.is_set(at)) {
+                        col.destroy_at(at);
+                    }
+                }
+                throw;
+            }
+        }
+    }
+
+    template <class T>
+    InlineStorage<T, N> &raw_column() noexcept {
+        return std::get<IndexOf<T, Ts...>>(columns_);
+    }
+
+    template <class T>
+    const InlineStorage<T, N> &raw_column() const noexcept {
+        return std::get<IndexOf<T, Ts...>>(columns_);
+    }
+
+private:
+    std::array<uint32_t, N> gens_;  // odd ones are free
+    std::array<uint32_t, N> free_;  // free slots in [count_, N), next one to take at count_
+    uint32_t count_ = 0;
+    std::tuple<InlineStorage<Ts, N>...> columns_;
+};
+}  // namespace tablez::sparse
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <tablez/aggregate.h>
+#include <tablez/changes.h>
 #include <tablez/id.h>
+#include <tablez/stats.h>
 #include <tablez/util.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -12,10 +19,28 @@
 #include "blob.h"
 #include "index.h"
 
+namespace tablez {
+template <class Table>
+struct QuerySource;
+
+namespace detail {
+template <class Table>
+struct ViewAccess;
+}  // namespace detail
+}  // namespace tablez
+
+namespace tablez::hybrid {
+template <class... Ts>
+class Table;
+}  // namespace tablez::hybrid
+
 namespace tablez::sparse {
 
-template <class T>
+template <class T, class Policy = WideIdPolicy>
 class Column {
+    using Id = BasicId<Policy>;
+    using Index = BasicIndex<Policy>;
+
 public:
     Column(const Index &index, const Blob<T> &data) : index_{index}, data_{data} {}
 
@@ -38,35 +63,79 @@ private:
     Blob<T> data_;
 };
 
-template <class... Ts>
-class Table {
+enum class SlotPolicy {
+    Lifo,         // reuse the most recently freed slot
+    LowestFirst,  // reuse the lowest free slot, keeps rows packed toward the front
+};
+
+// rows live at slots of their Ids, Ids get issued by Policy, see id.h
+template <class Policy, class... Ts>
+class BasicTable {
+    friend class hybrid::Table<Ts...>;
+    friend struct QuerySource<BasicTable>;
+    friend struct detail::ViewAccess<BasicTable>;
+
+    static constexpr uint32_t CLONE_CHUNK = 1 << 16;  // slots per thread at least
+    static constexpr bool NOTHROW_COPY = (std::is_nothrow_copy_constructible_v<Ts> && ...);
+
 public:
-    constexpr Table() noexcept = default;
+    using Id = BasicId<Policy>;
+    using Index = BasicIndex<Policy>;
+    using IdRemap = BasicIdRemap<Policy>;
 
-    Table(Table &&rhs) noexcept : index_(rhs.index_), free_{std::move(rhs.free_)}, columns_{rhs.columns_} {
+    constexpr BasicTable() noexcept = default;
+
+    BasicTable(BasicTable &&rhs) noexcept
+        : index_(rhs.index_),
+          free_{std::move(rhs.free_)},
+          free_bits_{std::move(rhs.free_bits_)},
+          lowest_free_word_{rhs.lowest_free_word_},
+          policy_{std::exchange(rhs.policy_, SlotPolicy::Lifo)},
+          columns_{rhs.columns_},
+          changes_(std::exchange(rhs.changes_, {})),
+          version_(rhs.version_),
+          tracked_(std::exchange(rhs.tracked_, 0)),
+          aggregates_(std::exchange(rhs.aggregates_, {})),
+          aggregated_(std::exchange(rhs.aggregated_, 0)),
+          shrink_policy_(rhs.shrink_policy_),
+          shrink_check_at_(rhs.shrink_check_at_),
+          stats_(rhs.stats_) {
         rhs.index_ = {};
         rhs.columns_ = {};
     }
 
-    Table &operator=(Table &&rhs) noexcept {
+    BasicTable &operator=(BasicTable &&rhs) noexcept {
         if (this == &rhs) {
             return *this;
         }
         destroy();
         index_ = std::exchange(rhs.index_, Index{});
         free_ = std::move(rhs.free_);
+        free_bits_ = std::move(rhs.free_bits_);
+        lowest_free_word_ = rhs.lowest_free_word_;
+        policy_ = std::exchange(rhs.policy_, SlotPolicy::Lifo);
         (..., (raw_column<Ts>() = std::exchange(rhs.raw_column<Ts>(), Blob<Ts>{})));
+        changes_ = std::exchange(rhs.changes_, {});
+        version_ = rhs.version_;
+        tracked_ = std::exchange(rhs.tracked_, 0);
+        aggregates_ = std::exchange(rhs.aggregates_, {});
+        aggregated_ = std::exchange(rhs.aggregated_, 0);
+        shrink_policy_ = rhs.shrink_policy_;
+        shrink_check_at_ = rhs.shrink_check_at_;
+        stats_ = rhs.stats_;
         return *this;
     }
 
-    ~Table() noexcept { destroy(); }
+    ~BasicTable() noexcept { destroy(); }
 
-    static Table with_capacity(uint32_t capacity) { return Table(capacity); }
+    static BasicTable with_capacity(uint32_t capacity) { return BasicTable(capacity); }
 
+    // aggregate of T gets recomputed on next read, as values may be written through
     template <class T>
         requires(IsUniqueAmong<T, Ts...>)
-    Column<T> column() noexcept {
-        return Column<T>{index_, raw_column<T>()};
+    Column<T, Policy> column() noexcept {
+        aggregate_of<T>().invalidate();
+        return Column<T, Policy>{index_, raw_column<T>()};
     }
 
     template <class... Us>
@@ -76,20 +145,105 @@ public:
 
         auto id = pop_free_index();
         (..., raw_column<Ts>().init_at(id.idx(), std::forward<Us>(args)));
+        if (aggregated_ != 0) {
+            (..., aggregate_of<Ts>().add(raw_column<Ts>().assume_init_at(id.idx())));
+        }
+        touch_row(id.idx());
+        stats_.add(&TableStats::inserts);
         return id;
     }
 
-    bool remove(Id id) noexcept {
+    // not noexcept: may shrink storage under ShrinkPolicy, which allocates
+    bool remove(Id id) {
+        [[maybe_unused]] auto timer = stats_.time(&TableStats::remove_ns);
         if (count() > 0 && push_free_index(id)) {
+            stats_.add(&TableStats::removes);
+            if (aggregated_ != 0) {
+                (..., aggregate_of<Ts>().remove(raw_column<Ts>().assume_init_at(id.idx())));
+            }
             (..., raw_column<Ts>().destroy_at(id.idx()));
+            touch_row(id.idx());
+            maybe_shrink();
             return true;
         }
+        stats_.add(&TableStats::stale_removes);
         return false;
     }
 
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    T *try_get(Id id) noexcept {
+        if (!contains(id)) {
+            return nullptr;
+        }
+        touch<T>(id.idx());
+        aggregate_of<T>().invalidate();
+        return &raw_column<T>().assume_init_at(id.idx());
+    }
+
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    const T *try_get(Id id) const noexcept {
+        if (!contains(id)) {
+            return nullptr;
+        }
+        return &raw_column<T>().assume_init_at(id.idx());
+    }
+
+    // same as writing through try_get, but keeps aggregate of T up to date
+    template <class T, class U>
+        requires(IsUniqueAmong<T, Ts...> && std::is_assignable_v<T &, U &&>)
+    bool set(Id id, U &&value) noexcept(std::is_nothrow_assignable_v<T &, U &&>) {
+        if (!contains(id)) {
+            return false;
+        }
+        auto &at = raw_column<T>().assume_init_at(id.idx());
+        aggregate_of<T>().remove(at);
+        at = std::forward<U>(value);
+        aggregate_of<T>().add(at);
+        touch<T>(id.idx());
+        return true;
+    }
+
+    // copies values of Us columns for every alive ids[i] into out[i] and sets found[i], generation and
+    //   column values get prefetched PREFETCH_DISTANCE lookups ahead. Returns number of found Ids
+    template <class... Us>
+        requires((IsUniqueAmong<Us, Ts...> && ...) && (std::is_copy_assignable_v<Us> && ...))
+    uint32_t get_many(std::span<const Id> ids, std::span<bool> found, std::span<Us>... out) const {
+        assert(found.size() >= ids.size() && ((out.size() >= ids.size()) && ...));
+        uint32_t found_count = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i + PREFETCH_DISTANCE < ids.size()) {
+                uint32_t ahead = ids[i + PREFETCH_DISTANCE].idx();
+                if (ahead < capacity()) {
+                    index_.prefetch(ahead);
+                    (..., raw_column<Us>().prefetch(ahead));
+                }
+            }
+
+            found[i] = contains(ids[i]);
+            if (found[i]) {
+                ++found_count;
+                (..., (out[i] = raw_column<Us>().assume_init_at(ids[i].idx())));
+            }
+        }
+        return found_count;
+    }
+
+    bool contains(Id id) const noexcept {
+        return id.idx() < capacity() && index_.is_set(id.idx()) && index_.get_unchecked(id.idx()).gen() == id.gen();
+    }
+
     template <class Func>
         requires(std::is_invocable_r_v<void, Func, Id, Ts &...>)
     void for_each_row(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, Id, Ts &...>) {
+        if (tracked_ != 0) {
+            ++version_;
+            for (auto &changes : changes_) {
+                changes.mark_all(capacity(), version_);
+            }
+        }
+        (..., aggregate_of<Ts>().invalidate());
         for (uint32_t i = 0; i < index_.capacity(); ++i) {
             if (index_.is_set(i)) {
                 func(index_.get_unchecked(i), raw_column<Ts>().assume_init_at(i)...);
@@ -101,18 +255,239 @@ public:
         (column<Ts>().destroy(), ...);
         (raw_column<Ts>().dealloc(), ...);
         free_.reset();
+        free_bits_.reset();
         index_.dealloc();
     }
 
+    // slots don't move, thus changes are tracked per chunk of slots: insert, remove, try_get and for_each_row
+    //   mark chunks they touch, writes through column() are not tracked
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    void track_changes(bool enable = true) {
+        auto &changes = changes_[IndexOf<T, Ts...>];
+        if (enable == changes.enabled()) {
+            return;
+        }
+        if (enable) {
+            changes.enable(capacity());
+            ++tracked_;
+        } else {
+            changes.disable();
+            --tracked_;
+        }
+    }
+
+    uint64_t version() const noexcept { return version_; }
+
+    // visits rows in chunks changed after since version, untracked column is visited whole
+    template <class T, class Func>
+        requires(IsUniqueAmong<T, Ts...> && std::is_invocable_r_v<void, Func, Id, const T &>)
+    void for_each_changed(uint64_t since, Func &&func) const {
+        auto &col = raw_column<T>();
+        changes_[IndexOf<T, Ts...>].for_each_changed(since, capacity(), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                if (index_.is_set(i)) {
+                    func(index_.get_unchecked(i), std::as_const(col.assume_init_at(i)));
+                }
+            }
+        });
+    }
+
+    // keeps count, sum, min and max of column T, updated by insert, remove and set in O(1)
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && Aggregatable<T>)
+    void track_aggregate(bool enable = true) {
+        auto &aggregate = aggregate_of<T>();
+        if (enable == aggregate.enabled()) {
+            return;
+        }
+        if (enable) {
+            aggregate.enable();
+            ++aggregated_;
+        } else {
+            aggregate.disable();
+            --aggregated_;
+        }
+    }
+
+    // recomputes aggregate if it got stale, O(1) otherwise. Not const, so that readers of a shared
+    //   const table never recompute it concurrently
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...> && Aggregatable<T>)
+    const Aggregate<T> &aggregate() {
+        auto &aggregate = aggregate_of<T>();
+        assert(aggregate.enabled());
+        if (aggregate.stale()) {
+            aggregate.recompute([this](auto &&add) {
+                for (uint32_t i = 0; i < capacity(); ++i) {
+                    if (index_.is_set(i)) {
+                        add(raw_column<T>().assume_init_at(i));
+                    }
+                }
+            });
+        }
+        return aggregate;
+    }
+
+    SlotPolicy slot_policy() const noexcept { return policy_; }
+
+    void set_slot_policy(SlotPolicy policy) {
+        if (policy == policy_) {
+            return;
+        }
+        policy_ = policy;
+        if (policy_ == SlotPolicy::LowestFirst) {
+            free_bits_.reset(new uint64_t[words_for(capacity())]);
+        } else {
+            free_bits_.reset();
+        }
+        rebuild_free();
+    }
+
+    // moves rows from the highest slots into the lowest free ones, so that all rows occupy [0, count()).
+    //   Moved rows get new Ids, old ones become invalid. Allocates remap before any row moves
+    IdRemap compact() {
+        IdRemap remap;
+        uint32_t moving = 0;  // rows at slots from count() on, each goes into a free slot below
+        for (uint32_t slot = count(); slot < capacity(); ++slot) {
+            moving += index_.is_set(slot);
+        }
+        remap.reserve(moving);
+        uint32_t lo = 0;
+        uint32_t hi = capacity();
+        while (true) {
+            while (lo < hi && index_.is_set(lo)) {
+                ++lo;
+            }
+            while (hi > lo && !index_.is_set(hi - 1)) {
+                --hi;
+            }
+            if (hi == lo) {
+                break;
+            }
+            uint32_t from = --hi;
+            Id old_id = index_.get_unchecked(from);
+            Id new_id = index_.push_unchecked(lo);
+            (..., raw_column<Ts>().init_at(lo, std::move(raw_column<Ts>().assume_init_at(from))));
+            (..., raw_column<Ts>().destroy_at(from));
+            index_.try_remove(old_id);
+            touch_row(lo);
+            touch_row(from);
+            remap.emplace_back(old_id, new_id);
+        }
+        rebuild_free();
+        return remap;
+    }
+
+    // deep copy with the same Ids and free slots order. Index and trivially copyable columns get copied with
+    //   memcpy, slots are split between up to threads threads for big tables. Columns which copies may throw
+    //   get copied on the calling thread only, if one throws, values copied so far get destroyed and it's
+    //   rethrown
+    BasicTable clone(uint32_t threads = 1) const
+        requires(std::is_copy_constructible_v<Ts> && ...)
+    {
+        BasicTable table(capacity());
+        std::copy_n(free_.get(), capacity(), table.free_.get());
+        table.policy_ = policy_;
+        if (policy_ == SlotPolicy::LowestFirst) {
+            table.free_bits_.reset(new uint64_t[words_for(capacity())]);
+            std::copy_n(free_bits_.get(), words_for(capacity()), table.free_bits_.get());
+            table.lowest_free_word_ = lowest_free_word_;
+        }
+        if constexpr (NOTHROW_COPY) {
+            threads = std::clamp<uint32_t>(threads, 1, std::max<uint32_t>(1, capacity() / CLONE_CHUNK));
+            parallel_chunks(capacity(), threads, [&](uint32_t begin, uint32_t end) {
+                (..., table.raw_column<Ts>().copy_in(raw_column<Ts>(), begin, end,
+                                                      [this](uint32_t idx) { return index_.is_set(idx); }));
+            });
+        } else {
+            clone_columns<0>(table);
+        }
+        // values are there, table's destructor may now go over its alive slots
+        table.index_.dealloc();
+        table.index_ = index_.clone();
+        table.changes_ = changes_;
+        table.version_ = version_;
+        table.tracked_ = tracked_;
+        table.aggregates_ = aggregates_;
+        table.aggregated_ = aggregated_;
+        table.shrink_policy_ = shrink_policy_;
+        table.shrink_check_at_ = shrink_check_at_;
+        return table;
+    }
+
+    // moves rows of rhs into free slots with one reservation, they get new Ids. rhs is left empty, keeping
+    //   its capacity. Pairs of rhs Id and new one get added to remap if given. Returns number of appended rows
+    uint32_t append(BasicTable &&rhs, IdRemap *remap = nullptr) {
+        assert(&rhs != this);
+        uint32_t n = append_rows(rhs, remap);
+        rhs.clear();
+        return n;
+    }
+
+    // same as append, but copies rows of rhs
+    uint32_t merge(const BasicTable &rhs, IdRemap *remap = nullptr)
+        requires(std::is_copy_constructible_v<Ts> && ...)
+    {
+        assert(&rhs != this);
+        return append_rows(rhs, remap);
+    }
+
+    // removes all rows, keeps capacity
+    void clear() noexcept {
+        (..., touch_all<Ts>());
+        (..., aggregate_of<Ts>().invalidate());
+        for (uint32_t slot = 0; slot < capacity(); ++slot) {
+            if (index_.is_set(slot)) {
+                (..., raw_column<Ts>().destroy_at(slot));
+                index_.try_remove(index_.get_unchecked(slot));
+            }
+        }
+        rebuild_free();
+    }
+
+    // drops free slots at the end, capacity can't get below the highest occupied slot
+    void shrink_to_fit() { shrink_to(count()); }
+
+    void set_shrink_policy(ShrinkPolicy policy) noexcept {
+        shrink_policy_ = policy;
+        shrink_check_at_ = UINT32_MAX;
+    }
+
     uint32_t count() const noexcept { return index_.count(); }
 
     uint32_t capacity() const noexcept { return index_.capacity(); }
 
+    // counters are zero unless built with TABLEZ_STATS, the rest gets computed on call
+    TableStats stats() const {
+        TableStats stats;
+        stats_.fill(stats);
+        stats.count = count();
+        stats.capacity = capacity();
+        stats.index_bytes = uint64_t{capacity()} * (Index::SLOT_BYTES + sizeof(uint32_t));
+        if (policy_ == SlotPolicy::LowestFirst) {
+            stats.index_bytes += uint64_t{words_for(capacity())} * sizeof(uint64_t);
+        }
+        stats.column_bytes = {uint64_t{capacity()} * sizeof(Ts)...};
+        constexpr uint32_t WORDS_PER_BLOCK = TableStats::OCCUPANCY_BLOCK / 64;
+        for (uint32_t word = 0; word < words_for(capacity()); ++word) {
+            if (word % WORDS_PER_BLOCK == 0) {
+                stats.block_occupancy.push_back(0);
+            }
+            stats.block_occupancy.back() += std::popcount(index_.occupancy_word(word));
+        }
+        return stats;
+    }
+
     void reserve_at_least(uint32_t new_capacity) {
         if (new_capacity <= capacity()) {
             return;
         }
-        new_capacity = std::max(capacity() * 2, new_capacity);
+        assert(new_capacity - 1 <= Id::MAX_IDX);
+        new_capacity = std::max<uint64_t>(std::min(uint64_t{capacity()} * 2, uint64_t{Id::MAX_IDX} + 1), new_capacity);
+        shrink_check_at_ = UINT32_MAX;
+        [[maybe_unused]] auto timer = stats_.time(&TableStats::grow_ns);
+        count_realloc(capacity());
 
         auto old_capacity = index_.capacity();
         index_.reserve_at_least(new_capacity);
@@ -127,10 +502,23 @@ public:
             new_free[i] = i;
         }
         free_ = std::move(new_free);
+        if (policy_ == SlotPolicy::LowestFirst) {
+            std::unique_ptr<uint64_t[]> new_bits{new uint64_t[words_for(new_capacity)]};
+            std::copy_n(free_bits_.get(), words_for(old_capacity), new_bits.get());
+            std::fill_n(new_bits.get() + words_for(old_capacity), words_for(new_capacity) - words_for(old_capacity), 0);
+            free_bits_ = std::move(new_bits);
+            for (uint32_t i = old_capacity; i < new_capacity; ++i) {
+                free_bits_[i / 64] |= uint64_t{1} << (i % 64);
+            }
+            lowest_free_word_ = std::min(lowest_free_word_, old_capacity / 64);
+        }
+        for (auto &changes : changes_) {
+            changes.reserve_at_least(new_capacity);
+        }
     }
 
 private:
-    explicit Table(uint32_t capacity)
+    explicit BasicTable(uint32_t capacity)
         : index_{Index::with_capacity(capacity)},
           free_{new uint32_t[capacity]},
           columns_(Blob<Ts>::with_capacity(capacity)...) {
@@ -139,14 +527,148 @@ private:
         }
     }
 
+    // copies values of column I and the ones after it into table, slot by slot for columns which copies may
+    //   throw. If one does, values copied so far get destroyed
+    template <size_t I>
+    void clone_columns(BasicTable &table) const {
+        if constexpr (I < sizeof...(Ts)) {
+            using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+            auto &col = table.raw_column<T>();
+            auto is_set = [this](uint32_t idx) { return index_.is_set(idx); };
+            uint32_t slot = 0;
+            try {
+                if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+                    col.copy_in(raw_column<T>(), 0, capacity(), is_set);
+                    slot = capacity();
+                } else {
+                    for (; slot < capacity(); ++slot) {
+                        col.copy_in(raw_column<T>(), slot, slot + 1, is_set);
+                    }
+                }
+                clone_columns<I + 1>(table);
+            } catch (...) {
+                col.destroy(slot, is_set);
+                throw;
+            }
+        }
+    }
+
+    // moves rows of non-const rhs, copies rows of const one
+    template <class Rhs>
+    uint32_t append_rows(Rhs &rhs, IdRemap *remap) {
+        reserve_at_least(count() + rhs.count());
+        if (remap != nullptr) {
+            remap->reserve(remap->size() + rhs.count());
+        }
+        for (uint32_t from = 0; from < rhs.capacity(); ++from) {
+            if (!rhs.index_.is_set(from)) {
+                continue;
+            }
+            Id id = pop_free_index();
+            if constexpr (std::is_const_v<Rhs>) {
+                (..., raw_column<Ts>().init_at(id.idx(), rhs.template raw_column<Ts>().assume_init_at(from)));
+            } else {
+                (..., raw_column<Ts>().init_at(id.idx(),
+                                               std::move(rhs.template raw_column<Ts>().assume_init_at(from))));
+            }
+            if (aggregated_ != 0) {
+                (..., aggregate_of<Ts>().add(raw_column<Ts>().assume_init_at(id.idx())));
+            }
+            touch_row(id.idx());
+            if (remap != nullptr) {
+                remap->emplace_back(rhs.index_.get_unchecked(from), id);
+            }
+        }
+        stats_.add(&TableStats::inserts, rhs.count());
+        return rhs.count();
+    }
+
+    void shrink_to(uint32_t new_capacity) {
+        uint32_t occupied_end = capacity();
+        while (occupied_end > new_capacity && !index_.is_set(occupied_end - 1)) {
+            --occupied_end;
+        }
+        new_capacity = occupied_end;
+        if (new_capacity == capacity()) {
+            return;
+        }
+
+        [[maybe_unused]] auto timer = stats_.time(&TableStats::grow_ns);
+        count_realloc(new_capacity);
+        (..., raw_column<Ts>().shrink_for_capacity(new_capacity, [this](uint32_t idx) { return index_.is_set(idx); }));
+        index_.shrink_to(new_capacity);
+        free_.reset(new uint32_t[new_capacity]);
+        if (policy_ == SlotPolicy::LowestFirst) {
+            free_bits_.reset(new uint64_t[words_for(new_capacity)]);
+        }
+        rebuild_free();
+    }
+
+    void maybe_shrink() {
+        if (shrink_policy_.low_water > 0 && count() <= shrink_check_at_ &&
+            count() < capacity() * shrink_policy_.low_water && capacity() > shrink_policy_.min_capacity) {
+            // occupied tail may keep capacity up, don't retry on every remove then
+            shrink_check_at_ = count() / 2;
+            shrink_to(std::max(count() * 2, shrink_policy_.min_capacity));
+        }
+    }
+
+    // every realloc moves alive rows and generations of slots kept
+    void count_realloc(uint32_t kept_slots) noexcept {
+        stats_.add(&TableStats::reallocs);
+        stats_.add(&TableStats::bytes_moved,
+                   uint64_t{count()} * (sizeof(Ts) + ...) + uint64_t{kept_slots} * Index::SLOT_BYTES);
+    }
+
+    static uint32_t words_for(uint32_t capacity) noexcept { return (uint64_t{capacity} + 63) / 64; }
+
+    // refills free slots structure of current policy from index, lowest slots get reused first
+    void rebuild_free() noexcept {
+        if (policy_ == SlotPolicy::LowestFirst) {
+            std::fill_n(free_bits_.get(), words_for(capacity()), 0);
+            for (uint32_t i = 0; i < capacity(); ++i) {
+                free_bits_[i / 64] |= uint64_t{!index_.is_set(i)} << (i % 64);
+            }
+            lowest_free_word_ = 0;
+        } else {
+            uint32_t stack_top = index_.count();
+            for (uint32_t i = 0; i < capacity(); ++i) {
+                if (!index_.is_set(i)) {
+                    free_[stack_top++] = i;
+                }
+            }
+        }
+    }
+
     Id pop_free_index() noexcept {
         assert(index_.count() < index_.capacity());
+        if (policy_ == SlotPolicy::LowestFirst) {
+            // everything below lowest_free_word_ is occupied
+            while (free_bits_[lowest_free_word_] == 0) {
+                ++lowest_free_word_;
+            }
+            uint64_t &word = free_bits_[lowest_free_word_];
+            uint32_t idx = lowest_free_word_ * 64 + std::countr_zero(word);
+            word &= word - 1;
+            return index_.push_unchecked(idx);
+        }
         uint32_t stack_top = index_.count();
         uint32_t idx = free_[stack_top];
         return index_.push_unchecked(idx);  // increases index_.count(), moves stack_top right
     }
 
     bool push_free_index(Id id) noexcept {
+        if (id.idx() >= capacity()) {
+            return false;
+        }
+        if (policy_ == SlotPolicy::LowestFirst) {
+            if (index_.try_remove(id)) {
+                free_bits_[id.idx() / 64] |= uint64_t{1} << (id.idx() % 64);
+                lowest_free_word_ = std::min(lowest_free_word_, id.idx() / 64);
+                return true;
+            }
+            return false;
+        }
         if (index_.try_remove(id)) { // moves stack_end left, thus, stack_top is now previous stack_end
             uint32_t stack_top = index_.count();
             free_[stack_top] = id.idx();
@@ -155,15 +677,66 @@ private:
         return false;
     }
 
+    template <class T>
+    Aggregate<T> &aggregate_of() noexcept {
+        return std::get<Aggregate<T>>(aggregates_);
+    }
+
+    void touch_row(uint32_t slot) noexcept {
+        if (tracked_ != 0) {
+            ++version_;
+            for (auto &changes : changes_) {
+                changes.mark(slot, version_);
+            }
+        }
+    }
+
+    template <class T>
+    void touch(uint32_t slot) noexcept {
+        if (tracked_ != 0) {
+            changes_[IndexOf<T, Ts...>].mark(slot, ++version_);
+        }
+    }
+
+    template <class T>
+    void touch_all() noexcept {
+        if (tracked_ != 0) {
+            changes_[IndexOf<T, Ts...>].mark_all(capacity(), ++version_);
+        }
+    }
+
     template <class T>
         requires(IsUniqueAmong<T, Ts...>)
     Blob<T> &raw_column() noexcept {
         return std::get<Blob<T>>(columns_);
     }
 
+    template <class T>
+        requires(IsUniqueAmong<T, Ts...>)
+    const Blob<T> &raw_column() const noexcept {
+        return std::get<Blob<T>>(columns_);
+    }
+
 private:
     Index index_;
-    std::unique_ptr<uint32_t[]> free_;  // acts as a stack of free indicies
+    std::unique_ptr<uint32_t[]> free_;       // acts as a stack of free indicies, used by SlotPolicy::Lifo
+    std::unique_ptr<uint64_t[]> free_bits_;  // set bit per free slot, used by SlotPolicy::LowestFirst
+    uint32_t lowest_free_word_ = 0;
+    SlotPolicy policy_ = SlotPolicy::Lifo;
     std::tuple<Blob<Ts>...> columns_;
+    std::array<ChangeTracker, sizeof...(Ts)> changes_;
+    uint64_t version_ = 0;
+    uint32_t tracked_ = 0;  // columns with enabled ChangeTracker
+    std::tuple<Aggregate<Ts>...> aggregates_;  // recomputed lazily on read
+    uint32_t aggregated_ = 0;                  // columns with enabled Aggregate
+    ShrinkPolicy shrink_policy_;
+    uint32_t shrink_check_at_ = UINT32_MAX;  // count at which maybe_shrink() tries again
+    [[no_unique_address]] StatsRecorder stats_;
 };
+
+template <class... Ts>
+using Table = BasicTable<WideIdPolicy, Ts...>;
+
+template <class... Ts>
+using CompactTable = BasicTable<CompactIdPolicy, Ts...>;
 }  // namespace tablez::sparse
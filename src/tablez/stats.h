@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tablez {
+
+// counters get collected only when built with TABLEZ_STATS defined (cmake -DTABLEZ_STATS=ON), otherwise
+//   tables hold no counters and recording compiles to nothing
+#ifdef TABLEZ_STATS
+inline constexpr bool STATS_ENABLED = true;
+#else
+inline constexpr bool STATS_ENABLED = false;
+#endif
+
+struct TableStats {
+    static constexpr uint32_t OCCUPANCY_BLOCK = 1024;  // slots per entry of block_occupancy
+
+    // counters, zero unless STATS_ENABLED
+    uint64_t inserts = 0;
+    uint64_t removes = 0;
+    uint64_t stale_removes = 0;  // removes of Ids with stale generation or out of capacity
+    uint64_t reallocs = 0;       // growths and shrinks of storage
+    uint64_t bytes_moved = 0;    // by reallocs, values of columns and index entries
+    uint64_t grow_ns = 0;        // spent in reallocs
+    uint64_t remove_ns = 0;
+
+    // computed on request
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+    uint64_t index_bytes = 0;  // index and free slots structures
+    std::vector<uint64_t> column_bytes;      // storage of every column, without memory owned by values
+    std::vector<uint32_t> block_occupancy;   // alive rows in every block of OCCUPANCY_BLOCK slots
+
+    // calls func(name, value) for every number, for export into metrics systems
+    template <class Func>
+    void for_each_metric(Func &&func) const {
+        func("inserts", inserts);
+        func("removes", removes);
+        func("stale_removes", stale_removes);
+        func("reallocs", reallocs);
+        func("bytes_moved", bytes_moved);
+        func("grow_ns", grow_ns);
+        func("remove_ns", remove_ns);
+        func("count", count);
+        func("capacity", capacity);
+        func("index_bytes", index_bytes);
+        for (size_t i = 0; i < column_bytes.size(); ++i) {
+            func("column_bytes." + std::to_string(i), column_bytes[i]);
+        }
+        for (size_t i = 0; i < block_occupancy.size(); ++i) {
+            func("block_occupancy." + std::to_string(i), block_occupancy[i]);
+        }
+    }
+};
+
+namespace detail {
+
+template <bool ENABLED>
+class StatsRecorder;
+
+template <>
+class StatsRecorder<false> {
+public:
+    struct Timer {};
+
+    void add(uint64_t TableStats::*, uint64_t = 1) noexcept {}
+
+    Timer time(uint64_t TableStats::*) noexcept { return {}; }
+
+    void fill(TableStats &) const noexcept {}
+};
+
+template <>
+class StatsRecorder<true> {
+public:
+    // adds time from its creation to a counter on destruction
+    class Timer {
+    public:
+        explicit Timer(uint64_t &ns) noexcept : ns_{ns}, start_{std::chrono::steady_clock::now()} {}
+
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+
+        ~Timer() {
+            ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_)
+                       .count();
+        }
+
+    private:
+        uint64_t &ns_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    void add(uint64_t TableStats::*counter, uint64_t n = 1) noexcept { counters_.*counter += n; }
+
+    Timer time(uint64_t TableStats::*counter) noexcept { return Timer{counters_.*counter}; }
+
+    void fill(TableStats &stats) const noexcept {
+        stats.inserts = counters_.inserts;
+        stats.removes = counters_.removes;
+        stats.stale_removes = counters_.stale_removes;
+        stats.reallocs = counters_.reallocs;
+        stats.bytes_moved = counters_.bytes_moved;
+        stats.grow_ns = counters_.grow_ns;
+        stats.remove_ns = counters_.remove_ns;
+    }
+
+private:
+    TableStats counters_;  // only counters are used
+};
+}  // namespace detail
+
+using StatsRecorder = detail::StatsRecorder<STATS_ENABLED>;
+}  // namespace tablez
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <tablez/id.h>
+#include <tablez/query.h>
+#include <tablez/util.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tablez {
+
+namespace detail {
+
+// keeps k best of pushed values, worst of them on top of the heap
+template <class T, class Cmp, class Id>
+class TopK {
+public:
+    using Entry = std::pair<Id, T>;
+
+    // rows is how many values may get pushed at most, k may be way above that
+    TopK(uint32_t k, Cmp cmp, uint32_t rows) : k_{k}, cmp_{cmp} { heap_.reserve(std::min(k, rows)); }
+
+    bool full() const noexcept { return heap_.size() == k_; }
+
+    // whether value would get in, without touching the heap
+    bool passes(const T &value) const { return !full() || cmp_(value, heap_.front().second); }
+
+    // k-th best value so far, for full heap only
+    const T &worst() const noexcept { return heap_.front().second; }
+
+    const Cmp &cmp() const noexcept { return cmp_; }
+
+    void push(Id id, const T &value) {
+        if (!full()) {
+            heap_.emplace_back(id, value);
+            std::push_heap(heap_.begin(), heap_.end(), by_value());
+        } else {
+            std::pop_heap(heap_.begin(), heap_.end(), by_value());
+            heap_.back() = {id, value};
+            std::push_heap(heap_.begin(), heap_.end(), by_value());
+        }
+    }
+
+    void merge(const TopK &rhs) {
+        for (auto &[id, value] : rhs.heap_) {
+            if (passes(value)) {
+                push(id, value);
+            }
+        }
+    }
+
+    std::vector<Entry> take_sorted() && {
+        std::sort_heap(heap_.begin(), heap_.end(), by_value());
+        return std::move(heap_);
+    }
+
+private:
+    auto by_value() const {
+        return [this](const Entry &lhs, const Entry &rhs) { return cmp_(lhs.second, rhs.second); };
+    }
+
+private:
+    uint32_t k_;
+    Cmp cmp_;
+    std::vector<Entry> heap_;
+};
+
+template <class T, class Source, class Cmp>
+void top_k_rows(const Source &source, uint32_t begin, uint32_t end, TopK<T, Cmp, typename Source::Id> &top) {
+    const T *values = source.template column<T>();
+    uint32_t row = begin;
+    for (; row < end && !top.full(); ++row) {
+        if (source.alive(row)) {
+            top.push(source.id(row), values[row]);
+        }
+    }
+    if (row == end) {
+        return;
+    }
+    // most rows fail against the current k-th value kept in a local, which is one predictable compare
+    T threshold = top.worst();
+    for (; row < end; ++row) {
+        if (source.alive(row) && top.cmp()(values[row], threshold)) [[unlikely]] {
+            top.push(source.id(row), values[row]);
+            threshold = top.worst();
+        }
+    }
+}
+}  // namespace detail
+
+// k alive rows with best values of column T, best first: a ranks before b when cmp(a, b), so default
+//   std::greater<> picks the largest. Single pass over the column with a bounded heap, O(k) memory
+//   per thread. With several threads each one selects from its range of rows, then heaps get merged
+template <class T, class Table, class Cmp = std::greater<>>
+    requires(std::is_invocable_r_v<bool, Cmp, const T &, const T &> && std::is_copy_constructible_v<T>)
+std::vector<std::pair<typename Table::Id, T>> top_k(const Table &table, uint32_t k, Cmp cmp = {},
+                                                    uint32_t threads = 1) {
+    QuerySource<Table> source{table};
+    uint32_t size = source.size();
+    if (k == 0) {
+        return {};
+    }
+    threads = std::clamp<uint32_t>(threads, 1, std::max<uint32_t>(1, size / 4096));
+
+    auto range_begin = [size, threads](uint32_t t) -> uint32_t { return uint64_t{size} * t / threads; };
+    std::vector<detail::TopK<T, Cmp, typename Table::Id>> tops;
+    tops.reserve(threads);
+    for (uint32_t t = 0; t < threads; ++t) {
+        tops.emplace_back(k, cmp, range_begin(t + 1) - range_begin(t));
+    }
+    parallel_chunks(threads, threads, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t t = begin; t < end; ++t) {
+            detail::top_k_rows(source, range_begin(t), range_begin(t + 1), tops[t]);
+        }
+    });
+    for (uint32_t t = 1; t < threads; ++t) {
+        tops[0].merge(tops[t]);
+    }
+    return std::move(tops[0]).take_sorted();
+}
+}  // namespace tablez
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <exception>
+#include <system_error>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace tablez {
 
@@ -12,4 +16,73 @@ struct IsUniqueAmongImpl {
 
 template <class T, class... Ts>
 static constexpr bool IsUniqueAmong = IsUniqueAmongImpl<T, Ts...>::Value;
+
+template <class T, class... Ts>
+struct IndexOfImpl;
+
+template <class T, class... Ts>
+struct IndexOfImpl<T, T, Ts...> {
+    constexpr static uint32_t Value = 0;
+};
+
+template <class T, class U, class... Ts>
+struct IndexOfImpl<T, U, Ts...> {
+    constexpr static uint32_t Value = 1 + IndexOfImpl<T, Ts...>::Value;
+};
+
+template <class T, class... Ts>
+static constexpr uint32_t IndexOf = IndexOfImpl<T, Ts...>::Value;
+
+// automatic shrinking: table shrinks to twice its count once count drops below low_water * capacity.
+//   Growth doubles capacity, thus low_water below 0.5 leaves a band where table neither grows nor shrinks
+struct ShrinkPolicy {
+    double low_water = 0.0;  // 0 disables automatic shrinking
+    uint32_t min_capacity = 0;
+};
+
+// how many lookups ahead batched accessors prefetch
+constexpr uint32_t PREFETCH_DISTANCE = 8;
+
+inline void prefetch(const void *ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr);
+#endif
+}
+
+// runs func(begin, end) on threads equal chunks of [0, n), the calling thread takes the first one and the
+//   ones no thread could be started for. If func throws, the exception of the lowest chunk gets rethrown
+//   once all of them are done
+template <class Func>
+void parallel_chunks(uint64_t n, uint32_t threads, Func &&func) {
+    std::vector<std::exception_ptr> errors(threads);
+    auto run = [&](uint32_t t) noexcept {
+        try {
+            func(n * t / threads, n * (t + 1) / threads);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    uint32_t started = 1;
+    try {
+        for (; started < threads; ++started) {
+            workers.emplace_back(run, started);
+        }
+    } catch (const std::system_error &) {
+        // out of threads, chunks left run below
+    }
+    for (uint32_t t = started; t < threads; ++t) {
+        run(t);
+    }
+    run(0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    for (auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
 }  // namespace tablez
\ No newline at end of file
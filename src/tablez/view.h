@@ -0,0 +1,217 @@
+#pragma once
+
+#include <tablez/dense/table.h>
+#include <tablez/id.h>
+#include <tablez/sparse/table.h>
+#include <tablez/util.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tablez {
+
+namespace detail {
+
+// what View needs of a table: finding rows by Id and reaching their values. at is row of dense table
+//   and slot of sparse one
+template <class Table>
+struct ViewAccess;
+
+template <class Policy, class... Ts>
+struct ViewAccess<dense::BasicTable<Policy, Ts...>> {
+    using Id = BasicId<Policy>;
+
+    static constexpr bool SPARSE = false;
+
+    template <class T>
+    static constexpr bool HAS = (std::is_same_v<T, Ts> || ...);
+
+    dense::BasicTable<Policy, Ts...> &table;
+
+    uint32_t count() const noexcept { return table.count(); }
+
+    bool find(Id id, uint32_t &at) const noexcept { return table.index_.try_get_idx_checked(id, at); }
+
+    void prefetch(Id id) const noexcept { table.index_.prefetch(id); }
+
+    template <class Func>
+    void for_each_id(Func &&func) const {
+        auto ids = table.ids();
+        for (uint32_t row = 0; row < ids.size(); ++row) {
+            func(ids[row], row);
+        }
+    }
+
+    template <class T>
+    T &get(uint32_t at) const noexcept {
+        return table.template raw_column<T>().get_unchecked(at);
+    }
+
+    // values may be written through View
+    template <class T>
+    void touch_all() const noexcept {
+        table.template touch_all<T>();
+        table.template aggregate_of<T>().invalidate();
+        table.template zone_of<T>().invalidate_all();
+    }
+};
+
+template <class Policy, class... Ts>
+struct ViewAccess<sparse::BasicTable<Policy, Ts...>> {
+    using Id = BasicId<Policy>;
+
+    static constexpr bool SPARSE = true;
+
+    template <class T>
+    static constexpr bool HAS = (std::is_same_v<T, Ts> || ...);
+
+    sparse::BasicTable<Policy, Ts...> &table;
+
+    uint32_t count() const noexcept { return table.count(); }
+
+    bool find(Id id, uint32_t &at) const noexcept {
+        at = id.idx();
+        return table.contains(id);
+    }
+
+    void prefetch(Id id) const noexcept {
+        if (id.idx() < table.capacity()) {
+            table.index_.prefetch(id.idx());
+        }
+    }
+
+    template <class Func>
+    void for_each_id(Func &&func) const {
+        table.index_.for_each([&](Id id) { func(id, id.idx()); });
+    }
+
+    uint32_t capacity() const noexcept { return table.capacity(); }
+
+    uint64_t occupancy_word(uint32_t word) const noexcept { return table.index_.occupancy_word(word); }
+
+    uint32_t gen(uint32_t slot) const noexcept { return table.index_.gens()[slot]; }
+
+    template <class T>
+    T &get(uint32_t at) const noexcept {
+        return table.template raw_column<T>().assume_init_at(at);
+    }
+
+    template <class T>
+    void touch_all() const noexcept {
+        table.template touch_all<T>();
+        table.template aggregate_of<T>().invalidate();
+    }
+};
+
+// index of the first table which has column T
+template <class T, class... Tables>
+constexpr size_t table_with() {
+    size_t idx = 0;
+    bool found = false;
+    (..., (found = found || ViewAccess<Tables>::template HAS<T>, idx += !found));
+    return idx;
+}
+}  // namespace detail
+
+// joins tables on equal Ids, i.e. tables sharing Id space, which got their rows inserted and removed
+//   in lockstep. Sparse only tables are joined by ANDing occupancy of their slots 64 at a time,
+//   otherwise the smallest table is iterated and rows of the others get looked up with prefetch
+template <class... Tables>
+class View {
+    using Id = typename detail::ViewAccess<std::tuple_element_t<0, std::tuple<Tables...>>>::Id;
+    static_assert((std::is_same_v<typename detail::ViewAccess<Tables>::Id, Id> && ...),
+                  "joined tables must issue Ids of the same policy");
+
+    static constexpr size_t N = sizeof...(Tables);
+    static constexpr bool ALL_SPARSE = (detail::ViewAccess<Tables>::SPARSE && ...);
+    static constexpr uint32_t BATCH = 256;
+
+public:
+    explicit View(Tables &...tables) noexcept : access_{detail::ViewAccess<Tables>{tables}...} {}
+
+    // visits rows present in every table with values of Cs columns, each taken from the first table having it
+    template <class... Cs, class Func>
+        requires((detail::table_with<Cs, Tables...>() < N) && ...) && std::is_invocable_r_v<void, Func, Id, Cs &...>
+    void for_each(Func &&func) {
+        (..., std::get<detail::table_with<Cs, Tables...>()>(access_).template touch_all<Cs>());
+        auto visit = [&](Id id, const std::array<uint32_t, N> &at) {
+            func(id, std::get<detail::table_with<Cs, Tables...>()>(access_).template get<Cs>(
+                         at[detail::table_with<Cs, Tables...>()])...);
+        };
+        if constexpr (ALL_SPARSE) {
+            join_occupancy(visit);
+        } else {
+            join_lookup(visit, std::make_index_sequence<N>{});
+        }
+    }
+
+    uint32_t count() {
+        uint32_t count = 0;
+        auto visit = [&](Id, const std::array<uint32_t, N> &) { ++count; };
+        if constexpr (ALL_SPARSE) {
+            join_occupancy(visit);
+        } else {
+            join_lookup(visit, std::make_index_sequence<N>{});
+        }
+        return count;
+    }
+
+private:
+    template <class Visit>
+    void join_occupancy(Visit &&visit) const {
+        uint32_t capacity = std::apply([](auto &...access) { return std::min({access.capacity()...}); }, access_);
+        for (uint32_t word = 0; word < (capacity + 63) / 64; ++word) {
+            uint64_t bits = std::apply(
+                [&](auto &...access) { return (~uint64_t{0} & ... & access.occupancy_word(word)); }, access_);
+            while (bits != 0) {
+                uint32_t slot = word * 64 + std::countr_zero(bits);
+                bits &= bits - 1;
+                uint32_t gen = std::get<0>(access_).gen(slot);
+                if (std::apply([&](auto &...access) { return ((access.gen(slot) == gen) && ...); }, access_)) {
+                    std::array<uint32_t, N> at;
+                    at.fill(slot);
+                    visit(Id{gen, slot}, at);
+                }
+            }
+        }
+    }
+
+    // collects Ids of the smallest table in batches, then looks them up in all tables
+    template <class Visit, size_t... Is>
+    void join_lookup(Visit &&visit, std::index_sequence<Is...>) const {
+        std::array<uint32_t, N> counts{std::get<Is>(access_).count()...};
+        size_t driver = std::min_element(counts.begin(), counts.end()) - counts.begin();
+
+        std::array<Id, BATCH> batch;
+        uint32_t size = 0;
+        auto flush = [&] {
+            for (uint32_t i = 0; i < size; ++i) {
+                if (i + PREFETCH_DISTANCE < size) {
+                    (..., std::get<Is>(access_).prefetch(batch[i + PREFETCH_DISTANCE]));
+                }
+                std::array<uint32_t, N> at;
+                if ((... && std::get<Is>(access_).find(batch[i], at[Is]))) {
+                    visit(batch[i], at);
+                }
+            }
+            size = 0;
+        };
+        auto collect = [&](Id id, uint32_t) {
+            batch[size++] = id;
+            if (size == BATCH) {
+                flush();
+            }
+        };
+        (..., (Is == driver ? std::get<Is>(access_).for_each_id(collect) : void()));
+        flush();
+    }
+
+private:
+    std::tuple<detail::ViewAccess<Tables>...> access_;
+};
+}  // namespace tablez
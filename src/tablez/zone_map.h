@@ -0,0 +1,156 @@
+#pragma once
+
+#include <tablez/aggregate.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace tablez {
+
+constexpr uint32_t ZONE_SHIFT = 10;
+constexpr uint32_t ZONE_ROWS = uint32_t{1} << ZONE_SHIFT;
+
+// min and max of a column per zone of ZONE_ROWS rows, for scans to skip zones a predicate can't match.
+//   Appends widen bounds of their zone. Removes and writes only mark zones dirty, those get recomputed by
+//   refresh() and never get skipped until then, thus skipped zones always hold no matching value
+template <class T>
+class ZoneMap {
+public:
+    bool enabled() const noexcept { return false; }
+    void reserve_at_least(uint32_t) noexcept {}
+    template <class U>
+    void push(uint32_t, const U &) noexcept {}
+    template <class U>
+    void widen(uint32_t, const U &) noexcept {}
+    template <class U>
+    void remove(uint32_t, const U &) noexcept {}
+    void invalidate(uint32_t) noexcept {}
+    void invalidate_all() noexcept {}
+
+    template <class Pred>
+    bool may_match(uint32_t, const Pred &) const noexcept {
+        return true;
+    }
+};
+
+template <Aggregatable T>
+class ZoneMap<T> {
+    struct Zone {
+        T min{};
+        T max{};
+        bool dirty = true;
+        bool unbounded = false;  // has NaN, which no bounds hold
+    };
+
+public:
+    bool enabled() const noexcept { return enabled_; }
+
+    void enable(uint32_t capacity) {
+        zones_.assign(zones_for(capacity), Zone{});
+        enabled_ = true;
+    }
+
+    void disable() noexcept { *this = ZoneMap{}; }
+
+    void reserve_at_least(uint32_t capacity) {
+        if (enabled_ && zones_for(capacity) > zones_.size()) {
+            zones_.resize(zones_for(capacity));
+        }
+    }
+
+    // value got appended at row, the first row of a zone resets it
+    void push(uint32_t row, const T &value) noexcept {
+        if (!enabled_) {
+            return;
+        }
+        Zone &zone = zones_[row >> ZONE_SHIFT];
+        if ((row & (ZONE_ROWS - 1)) == 0) {
+            zone = Zone{.min = value, .max = value, .dirty = false, .unbounded = is_nan(value)};
+        } else {
+            widen_zone(zone, value);
+        }
+    }
+
+    // value got moved or written into row
+    void widen(uint32_t row, const T &value) noexcept {
+        if (enabled_) {
+            widen_zone(zones_[row >> ZONE_SHIFT], value);
+        }
+    }
+
+    // value left row, bounds still hold, but get tightened on next read if it was one of them
+    void remove(uint32_t row, const T &value) noexcept {
+        if (enabled_) {
+            Zone &zone = zones_[row >> ZONE_SHIFT];
+            zone.dirty |= !(zone.min < value && value < zone.max);
+        }
+    }
+
+    // row may have been written through a reference
+    void invalidate(uint32_t row) noexcept {
+        if (enabled_) {
+            zones_[row >> ZONE_SHIFT].dirty = true;
+        }
+    }
+
+    void invalidate_all() noexcept {
+        for (Zone &zone : zones_) {
+            zone.dirty = true;
+        }
+    }
+
+    // recomputes dirty zones of rows [0, count)
+    void refresh(const T *values, uint32_t count) noexcept {
+        for (uint32_t idx = 0; idx < zones_for(count); ++idx) {
+            Zone &zone = zones_[idx];
+            if (!zone.dirty) {
+                continue;
+            }
+            uint32_t begin = idx << ZONE_SHIFT;
+            uint32_t end = std::min(count, begin + ZONE_ROWS);
+            zone = Zone{.min = values[begin], .max = values[begin], .dirty = false};
+            for (uint32_t row = begin; row < end; ++row) {
+                widen_zone(zone, values[row]);
+            }
+        }
+    }
+
+    // whether any value of zone may pass pred, dirty zone always may
+    template <class Pred>
+    bool may_match(uint32_t zone, const Pred &pred) const noexcept {
+        const Zone &at = zones_[zone];
+        return at.dirty || at.unbounded || pred.may_match(at.min, at.max);
+    }
+
+    bool dirty(uint32_t zone) const noexcept { return zones_[zone].dirty; }
+
+    // bounds of zone, refreshed zone map only
+    T min(uint32_t zone) const noexcept { return zones_[zone].min; }
+
+    T max(uint32_t zone) const noexcept { return zones_[zone].max; }
+
+private:
+    static uint32_t zones_for(uint32_t rows) noexcept { return (uint64_t{rows} + ZONE_ROWS - 1) >> ZONE_SHIFT; }
+
+    static bool is_nan(const T &value) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::isnan(value);
+        }
+        return false;
+    }
+
+    static void widen_zone(Zone &zone, const T &value) noexcept {
+        zone.min = std::min(zone.min, value);
+        zone.max = std::max(zone.max, value);
+        zone.unbounded |= is_nan(value);
+    }
+
+private:
+    std::vector<Zone> zones_;  // by zone of capacity
+    bool enabled_ = false;
+};
+}  // namespace tablez
@@ -0,0 +1,89 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/command_buffer.h>
+#include <tablez/dense/table.h>
+#include <tablez/sparse/table.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+class CommandBufferTest : public Test {};
+
+TEST_F(CommandBufferTest, during_for_each) {
+    tablez::dense::Table<int, std::string> table;
+    for (int i = 0; i < 100; ++i) {
+        table.insert(i, std::to_string(i));
+    }
+
+    tablez::CommandBuffer<decltype(table)> commands;
+    table.for_each<int>([&](tablez::Id id, int &value) {
+        if (value % 2 == 0) {
+            commands.remove(id);
+            commands.remove(id);  // repeats get coalesced
+        }
+        if (value % 10 == 0) {
+            commands.insert(value + 1000, "new");
+        }
+    });
+    ASSERT_EQ(table.count(), 100);
+
+    auto inserted = commands.flush(table);
+    ASSERT_TRUE(commands.empty());
+    ASSERT_EQ(inserted.size(), 10);
+    ASSERT_EQ(table.count(), 60);
+    table.for_each<int>([](tablez::Id, int &value) { ASSERT_TRUE(value % 2 == 1 || value >= 1000); });
+    for (auto id : inserted) {
+        ASSERT_EQ(*table.try_get<std::string>(id), "new");
+    }
+}
+
+TEST_F(CommandBufferTest, shards) {
+    tablez::sparse::Table<int> table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(table.insert(i));
+    }
+
+    constexpr uint32_t THREADS = 4;
+    tablez::CommandBuffer<decltype(table)> commands(THREADS);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            auto &shard = commands.shard(t);
+            for (uint32_t i = t; i < ids.size(); i += THREADS) {
+                if (i % 4 != 0) {
+                    shard.remove(ids[i]);
+                }
+                shard.insert(-1);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto inserted = commands.flush(table);
+    ASSERT_EQ(inserted.size(), 1000);
+    ASSERT_EQ(table.count(), 1250);
+    for (uint32_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(table.contains(ids[i]), i % 4 == 0);
+    }
+}
+
+TEST_F(CommandBufferTest, remove_many) {
+    tablez::dense::Table<int> table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 10; ++i) {
+        ids.push_back(table.insert(i));
+    }
+    std::vector<tablez::Id> removes{ids[0], ids[9], ids[5], ids[0], ids[3]};
+    ASSERT_EQ(table.remove_many(removes), 4);
+    ASSERT_EQ(table.remove_many(removes), 0);
+    ASSERT_EQ(table.count(), 6);
+    for (int i : {1, 2, 4, 6, 7, 8}) {
+        ASSERT_EQ(*table.try_get<int>(ids[i]), i);
+    }
+}
@@ -0,0 +1,144 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/arrow.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+class DenseArrowTest : public Test {};
+
+TEST_F(DenseArrowTest, export_import) {
+    using Table = tablez::dense::Table<int32_t, double, bool, std::string>;
+    auto table = std::make_shared<Table>();
+    for (int i = 0; i < 20; ++i) {
+        table->insert(i, i * 0.5, i % 3 == 0, std::string(i % 4, 'x'));
+    }
+
+    ArrowSchema schema;
+    ArrowArray array;
+    std::vector<std::string> names{"i", "d", "b", "s"};
+    tablez::dense::export_arrow(std::shared_ptr<const Table>(table), &schema, &array, names);
+    std::weak_ptr<Table> pinned = table;
+    table.reset();
+    ASSERT_FALSE(pinned.expired());
+
+    ASSERT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 5);
+    ASSERT_STREQ(schema.children[0]->name, "id");
+    ASSERT_STREQ(schema.children[1]->format, "i");
+    ASSERT_STREQ(schema.children[2]->format, "g");
+    ASSERT_STREQ(schema.children[3]->format, "b");
+    ASSERT_STREQ(schema.children[4]->format, "u");
+    ASSERT_STREQ(schema.children[4]->name, "s");
+    ASSERT_EQ(array.length, 20);
+
+    // primitive columns aren't copied
+    auto locked = pinned.lock();
+    ASSERT_EQ(array.children[1]->buffers[1], locked->values<int32_t>().data());
+    ASSERT_EQ(array.children[0]->buffers[1], locked->ids().data());
+    locked.reset();
+
+    auto imported = tablez::dense::import_arrow<int32_t, double, bool, std::string>(schema, array);
+    ASSERT_TRUE(imported.has_value());
+    ASSERT_EQ(imported->count(), 20);
+    imported->for_each_row([](tablez::Id, int32_t &i, double &d, bool &b, std::string &s) {
+        ASSERT_EQ(d, i * 0.5);
+        ASSERT_EQ(b, i % 3 == 0);
+        ASSERT_EQ(s, std::string(i % 4, 'x'));
+    });
+    ASSERT_FALSE((tablez::dense::import_arrow<int64_t, double, bool, std::string>(schema, array).has_value()));
+
+    schema.release(&schema);
+    ASSERT_FALSE(pinned.expired());
+    array.release(&array);
+    ASSERT_TRUE(pinned.expired());
+    ASSERT_EQ(array.release, nullptr);
+}
+
+TEST_F(DenseArrowTest, move_child_out) {
+    using Table = tablez::dense::Table<int32_t, std::string>;
+    auto table = std::make_shared<Table>();
+    for (int i = 0; i < 10; ++i) {
+        table->insert(i, std::to_string(i));
+    }
+    std::weak_ptr<Table> pinned = table;
+
+    ArrowSchema schema;
+    ArrowArray array;
+    tablez::dense::export_arrow(std::move(table), &schema, &array);  // Ts deduced from non-const table
+
+    // consumer moves the string column out and releases the rest
+    ArrowSchema child_schema = *schema.children[2];
+    schema.children[2]->release = nullptr;
+    ArrowArray child = *array.children[2];
+    array.children[2]->release = nullptr;
+    schema.release(&schema);
+    array.release(&array);
+    ASSERT_FALSE(pinned.expired());
+
+    ASSERT_STREQ(child_schema.format, "u");
+    ASSERT_STREQ(child_schema.name, "1");
+    ASSERT_EQ(child.length, 10);
+    auto *offsets = static_cast<const int32_t *>(child.buffers[1]);
+    auto *chars = static_cast<const char *>(child.buffers[2]);
+    ASSERT_EQ(std::string(chars + offsets[7], chars + offsets[8]), "7");
+
+    child_schema.release(&child_schema);
+    child.release(&child);
+    ASSERT_TRUE(pinned.expired());
+}
+
+TEST_F(DenseArrowTest, import_short_child) {
+    using Table = tablez::dense::Table<int32_t, double>;
+    auto table = std::make_shared<Table>();
+    for (int i = 0; i < 10; ++i) {
+        table->insert(i, i * 2.0);
+    }
+
+    ArrowSchema schema;
+    ArrowArray array;
+    tablez::dense::export_arrow(std::shared_ptr<const Table>(std::move(table)), &schema, &array);
+
+    array.offset = 2;
+    array.length = 8;
+    auto sliced = tablez::dense::import_arrow<int32_t, double>(schema, array);
+    ASSERT_TRUE(sliced.has_value());
+    ASSERT_EQ(sliced->count(), 8);
+
+    array.length = 9;  // children end before the last row
+    ASSERT_FALSE((tablez::dense::import_arrow<int32_t, double>(schema, array).has_value()));
+    array.offset = 0;
+    array.children[2]->length = 5;
+    ASSERT_FALSE((tablez::dense::import_arrow<int32_t, double>(schema, array).has_value()));
+
+    schema.release(&schema);
+    array.release(&array);
+}
+
+TEST_F(DenseArrowTest, import_large_utf8) {
+    std::vector<int64_t> offsets{0, 3, 3, 8};
+    std::string chars = "onethree";
+    std::vector<const void *> buffers{nullptr, offsets.data(), chars.data()};
+    ArrowSchema child_schema{.format = "U", .name = "s", .metadata = nullptr, .flags = 0, .n_children = 0,
+                             .children = nullptr, .dictionary = nullptr, .release = nullptr, .private_data = nullptr};
+    ArrowArray child{.length = 3, .null_count = 0, .offset = 0, .n_buffers = 3, .n_children = 0,
+                     .buffers = buffers.data(), .children = nullptr, .dictionary = nullptr, .release = nullptr,
+                     .private_data = nullptr};
+    ArrowSchema *child_schemas[] = {&child_schema};
+    ArrowArray *children[] = {&child};
+    std::vector<const void *> struct_buffers{nullptr};
+    ArrowSchema schema{.format = "+s", .name = "", .metadata = nullptr, .flags = 0, .n_children = 1,
+                       .children = child_schemas, .dictionary = nullptr, .release = nullptr, .private_data = nullptr};
+    ArrowArray array{.length = 3, .null_count = 0, .offset = 0, .n_buffers = 1, .n_children = 1,
+                     .buffers = struct_buffers.data(), .children = children, .dictionary = nullptr,
+                     .release = nullptr, .private_data = nullptr};
+
+    auto imported = tablez::dense::import_arrow<std::string>(schema, array);
+    ASSERT_TRUE(imported.has_value());
+    auto values = imported->values<std::string>();
+    ASSERT_THAT(std::vector(values.begin(), values.end()), ElementsAre("one", "", "three"));
+}
@@ -0,0 +1,133 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/cow_table.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace tablez;
+
+class DenseCowTableTest : public Test {};
+
+TEST_F(DenseCowTableTest, base) {
+    dense::CowTable<int, std::string> table;
+
+    auto fst = table.insert(1, "one");
+    auto sec = table.insert(2, "two");
+    auto thd = table.insert(3, "three");
+    ASSERT_EQ(table.count(), 3);
+    ASSERT_EQ(table.capacity(), dense::COW_CHUNK_SIZE);
+
+    ASSERT_TRUE(table.remove(fst));
+    ASSERT_FALSE(table.remove(fst));
+    ASSERT_EQ(table.try_get<int>(fst), nullptr);
+    ASSERT_EQ(*table.try_get<std::string>(thd), "three");
+
+    std::vector<int> ints;
+    table.for_each<int>([&ints](Id, const int &value) { ints.push_back(value); });
+    ASSERT_THAT(ints, ElementsAre(3, 2));
+
+    auto fst_ = table.insert(4, "four");
+    ASSERT_EQ(fst_.idx(), fst.idx());
+    ASSERT_GT(fst_.gen(), fst.gen());
+    ASSERT_EQ(*table.try_get<int>(sec), 2);
+}
+
+TEST_F(DenseCowTableTest, remove_last) {
+    dense::CowTable<int, std::string> table;
+
+    auto fst = table.insert(1, "one");
+    auto sec = table.insert(2, "two");
+    ASSERT_TRUE(table.remove(sec));
+    ASSERT_EQ(table.try_get<int>(sec), nullptr);
+
+    auto sec_ = table.insert(3, "three");
+    ASSERT_EQ(sec_.idx(), sec.idx());
+    ASSERT_GT(sec_.gen(), sec.gen());
+    ASSERT_EQ(table.try_get<int>(sec), nullptr);
+    ASSERT_EQ(*table.try_get<int>(sec_), 3);
+    ASSERT_EQ(*table.try_get<int>(fst), 1);
+
+    ASSERT_TRUE(table.remove(sec_));
+    ASSERT_TRUE(table.remove(fst));
+    ASSERT_EQ(table.count(), 0);
+    ASSERT_EQ(table.try_get<int>(fst), nullptr);
+}
+
+TEST_F(DenseCowTableTest, snapshot) {
+    dense::CowTable<int, std::string> table;
+    std::vector<Id> ids;
+    for (int i = 0; i < 3000; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+
+    auto snapshot = table.snapshot();
+    ASSERT_EQ(table.shared_chunks(), 2 * 3 + 2 * 3);  // three chunks of index, ids and both columns
+
+    *table.try_get<int>(ids[10]) = -10;
+    ASSERT_TRUE(table.remove(ids[20]));
+    table.insert(5000, "5000");
+
+    ASSERT_EQ(snapshot.count(), 3000);
+    ASSERT_EQ(*snapshot.try_get<int>(ids[10]), 10);
+    ASSERT_EQ(*snapshot.try_get<std::string>(ids[20]), "20");
+    ASSERT_EQ(*table.try_get<int>(ids[10]), -10);
+    ASSERT_EQ(table.try_get<int>(ids[20]), nullptr);
+
+    // last chunks are untouched, thus still shared
+    const auto &live = table;
+    ASSERT_EQ(snapshot.try_get<int>(ids[1500]), live.try_get<int>(ids[1500]));
+    ASSERT_NE(snapshot.try_get<int>(ids[10]), live.try_get<int>(ids[10]));
+
+    int64_t sum = 0;
+    snapshot.for_each<int>([&sum](Id, const int &value) { sum += value; });
+    ASSERT_EQ(sum, 2999 * 3000 / 2);
+
+    snapshot = {};
+    ASSERT_EQ(table.shared_chunks(), 0);
+}
+
+TEST_F(DenseCowTableTest, remove_into_dropped_chunk) {
+    dense::CowTable<int, std::string> table;
+    std::vector<Id> ids;
+    for (int i = 0; i < int{dense::COW_CHUNK_SIZE} + 1; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+
+    // last row is alone in the last chunk of columns, which gets dropped, not copied
+    auto snapshot = table.snapshot();
+    uint32_t shared = table.shared_chunks();
+    ASSERT_TRUE(table.remove(ids[0]));
+    ASSERT_EQ(*table.try_get<std::string>(ids.back()), std::to_string(dense::COW_CHUNK_SIZE));
+    ASSERT_EQ(*snapshot.try_get<std::string>(ids[0]), "0");
+    ASSERT_EQ(*snapshot.try_get<std::string>(ids.back()), std::to_string(dense::COW_CHUNK_SIZE));
+    // both chunks of index and ids got written, first ones of columns too, last ones of columns got dropped
+    ASSERT_EQ(shared, 4 * 2);
+    ASSERT_EQ(table.shared_chunks(), 0);
+}
+
+TEST_F(DenseCowTableTest, snapshot_released_by_reader) {
+    dense::CowTable<int> table;
+    std::vector<Id> ids;
+    for (int i = 0; i < 3000; ++i) {
+        ids.push_back(table.insert(i));
+    }
+    for (int round = 0; round < 100; ++round) {
+        auto snapshot = table.snapshot();
+        std::thread reader([snapshot = std::move(snapshot)]() mutable {
+            int64_t sum = 0;
+            snapshot.for_each<int>([&sum](Id, const int &value) { sum += value; });
+            snapshot = {};
+            ASSERT_GE(sum, 0);
+        });
+        // writes race with reads until the reader lets go, after that they are in place
+        for (int i = 0; i < 3000; i += 100) {
+            *table.try_get<int>(ids[i]) += 1;
+        }
+        reader.join();
+    }
+    ASSERT_EQ(table.shared_chunks(), 0);
+    ASSERT_EQ(*table.try_get<int>(ids[100]), 200);
+}
@@ -0,0 +1,52 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/csv.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace testing;
+
+class DenseCsvTest : public Test {};
+
+template <class T>
+std::vector<T> to_vector(std::span<const T> values) {
+    return {values.begin(), values.end()};
+}
+
+TEST_F(DenseCsvTest, parse) {
+    auto table = tablez::dense::parse_csv<int, double, bool, std::string>(
+        "i,d,b,s\r\n1,0.5,true,one\r\n\n-2,1e3,0,\r\n3,-0.25,1,three");
+    ASSERT_TRUE(table.has_value());
+    ASSERT_EQ(table->count(), 3);
+    ASSERT_THAT(to_vector(table->values<int>()), ElementsAre(1, -2, 3));
+    ASSERT_THAT(to_vector(table->values<double>()), ElementsAre(0.5, 1000.0, -0.25));
+    ASSERT_THAT(to_vector(table->values<bool>()), ElementsAre(true, false, true));
+    ASSERT_THAT(to_vector(table->values<std::string>()), ElementsAre("one", "", "three"));
+
+    ASSERT_FALSE((tablez::dense::parse_csv<int, double>("1,x\n", {.header = false})).has_value());
+    ASSERT_FALSE((tablez::dense::parse_csv<int, double>("1\n", {.header = false})).has_value());
+    ASSERT_FALSE((tablez::dense::parse_csv<int, double>("1,2,3\n", {.header = false})).has_value());
+}
+
+TEST_F(DenseCsvTest, threads) {
+    std::string text;
+    for (int i = 0; i < 100000; ++i) {
+        text += std::to_string(i) + ';' + std::to_string(i % 7) + '\n';
+    }
+    auto path = testing::TempDir() + "tablez_csv_test.csv";
+    std::ofstream(path) << text;
+
+    auto table = tablez::dense::load_csv<int, uint8_t>(path.c_str(), {.delimiter = ';', .header = false, .threads = 4});
+    std::remove(path.c_str());
+    ASSERT_TRUE(table.has_value());
+    ASSERT_EQ(table->count(), 100000);
+    auto values = table->values<int>();
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(values[i], i);
+        ASSERT_EQ(table->values<uint8_t>()[i], i % 7);
+        ASSERT_EQ(*table->try_get<int>(table->ids()[i]), i);
+    }
+    ASSERT_FALSE((tablez::dense::load_csv<int, uint8_t>("/nonexistent/file.csv")).has_value());
+}
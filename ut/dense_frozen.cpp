@@ -0,0 +1,99 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/frozen.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace tablez;
+
+class DenseFrozenTest : public Test {};
+
+TEST_F(DenseFrozenTest, packed_column) {
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 1000; ++i) {
+        values.push_back(1'700'000'000'000 + i * 1000 + i % 7);  // timestamps, good for delta
+    }
+    values.push_back(-5);  // frame-of-reference of the last block gets wide
+    values.push_back(std::numeric_limits<int64_t>::max());
+
+    auto packed = dense::PackedColumn<int64_t>::encode(values);
+    ASSERT_EQ(packed.count(), values.size());
+    ASSERT_LT(packed.memory_bytes(), values.size() * sizeof(int64_t) / 3);
+
+    std::vector<int64_t> decoded(values.size());
+    packed.decode(decoded.data());
+    ASSERT_EQ(decoded, values);
+
+    int64_t sum = 0;
+    for (auto v : values) {
+        sum = static_cast<int64_t>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(v));
+    }
+    ASSERT_EQ(packed.sum(), sum);
+}
+
+TEST_F(DenseFrozenTest, freeze_thaw) {
+    dense::Table<int, int64_t, std::string> table;
+    std::vector<Id> ids;
+    for (int i = 0; i < 300; ++i) {
+        ids.push_back(table.insert(i % 10, int64_t{1000} + i, std::to_string(i)));
+    }
+    for (int i = 0; i < 300; i += 3) {
+        ASSERT_TRUE(table.remove(ids[i]));
+    }
+
+    std::vector<std::pair<Id, int>> expected;
+    table.for_each<int>([&expected](Id id, int value) { expected.emplace_back(id, value); });
+    int64_t expected_sum = 0;
+    table.for_each<int64_t>([&expected_sum](Id, int64_t value) { expected_sum += value; });
+
+    auto frozen = dense::FrozenTable<int, int64_t, std::string>::freeze(std::move(table));
+    ASSERT_EQ(table.count(), 0);
+    ASSERT_EQ(frozen.count(), 200);
+
+    std::vector<std::pair<Id, int>> actual;
+    frozen.for_each<int>([&actual](Id id, int value) { actual.emplace_back(id, value); });
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_EQ(actual[i].first.gen(), expected[i].first.gen());
+        ASSERT_EQ(actual[i].first.idx(), expected[i].first.idx());
+        ASSERT_EQ(actual[i].second, expected[i].second);
+    }
+    ASSERT_EQ(frozen.sum<int64_t>(), expected_sum);
+
+    uint32_t strings = 0;
+    frozen.for_each<std::string>([&strings](Id, const std::string &value) { strings += !value.empty(); });
+    ASSERT_EQ(strings, 200);
+
+    auto thawed = std::move(frozen).thaw();
+    ASSERT_EQ(frozen.count(), 0);
+    ASSERT_EQ(thawed.count(), 200);
+    ASSERT_FALSE(thawed.remove(ids[0]));
+    ASSERT_TRUE(thawed.remove(ids[1]));
+
+    auto fresh = thawed.insert(42, int64_t{42}, "42");
+    ASSERT_EQ(fresh.idx(), ids[1].idx());
+    ASSERT_GT(fresh.gen(), ids[1].gen());
+}
+
+TEST_F(DenseFrozenTest, thaw_after_shrink) {
+    dense::Table<int, std::string> table;
+    std::vector<Id> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+    for (Id id : ids) {
+        ASSERT_TRUE(table.remove(id));
+    }
+    table.shrink_to_fit();
+
+    auto thawed = dense::FrozenTable<int, std::string>::freeze(std::move(table)).thaw();
+    for (int i = 0; i < 100; ++i) {
+        thawed.insert(-i, "");
+    }
+    for (Id id : ids) {
+        ASSERT_EQ(thawed.try_get<int>(id), nullptr);
+    }
+}
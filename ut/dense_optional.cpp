@@ -0,0 +1,75 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/table.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+using namespace tablez;
+
+class DenseOptionalTest : public Test {};
+
+using OptName = tablez::Optional<std::string>;
+using Table = dense::Table<int, OptName>;
+
+std::vector<std::pair<int, std::string>> present(Table &table) {
+    std::vector<std::pair<int, std::string>> rows;
+    table.for_each<OptName>(
+        [&](Id id, std::string &name) { rows.emplace_back(*table.try_get<int>(id), name); });
+    return rows;
+}
+
+TEST_F(DenseOptionalTest, insert_remove) {
+    Table table;
+    auto fst = table.insert(1, "one");
+    auto sec = table.insert(2, std::nullopt);
+    auto thd = table.insert(3, OptName{"three"});
+    auto fth = table.insert(4, OptName{});
+    ASSERT_EQ(table.count_present<OptName>(), 2);
+    ASSERT_EQ(*table.try_get<OptName>(fst), "one");
+    ASSERT_EQ(table.try_get<OptName>(sec), nullptr);
+    ASSERT_THAT(present(table), ElementsAre(Pair(1, "one"), Pair(3, "three")));
+
+    // last rows move in: absent into present, present into absent
+    ASSERT_TRUE(table.remove(fst));
+    ASSERT_EQ(table.try_get<OptName>(fth), nullptr);
+    ASSERT_TRUE(table.remove(sec));
+    ASSERT_EQ(*table.try_get<OptName>(thd), "three");
+    ASSERT_THAT(present(table), ElementsAre(Pair(3, "three")));
+
+    ASSERT_TRUE(table.set<OptName>(fth, "four"));
+    ASSERT_TRUE(table.set<OptName>(thd, std::nullopt));
+    ASSERT_THAT(present(table), ElementsAre(Pair(4, "four")));
+    ASSERT_EQ(table.count_present<OptName>(), 1);
+
+    table.clear();
+    ASSERT_EQ(table.count_present<OptName>(), 0);
+}
+
+TEST_F(DenseOptionalTest, grow_clone_append) {
+    Table table;
+    std::vector<Id> ids;
+    for (int i = 0; i < 5000; ++i) {
+        ids.push_back(table.insert(i, i % 50 == 0 ? OptName{std::to_string(i)} : std::nullopt));
+    }
+    for (int i = 0; i < 5000; i += 3) {
+        table.remove(ids[i]);
+    }
+    auto rows = present(table);
+    ASSERT_EQ(rows.size(), table.count_present<OptName>());
+    for (auto &[value, name] : rows) {
+        ASSERT_EQ(std::to_string(value), name);
+    }
+
+    auto copy = table.clone();
+    ASSERT_EQ(present(copy), rows);
+
+    Table other;
+    other.insert(-1, std::nullopt);
+    other.append(std::move(copy));
+    ASSERT_EQ(present(other), rows);
+    ASSERT_EQ(other.count(), table.count() + 1);
+}
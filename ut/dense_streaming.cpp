@@ -0,0 +1,96 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/streaming.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace tablez;
+
+class DenseStreamingTest : public Test {};
+
+TEST_F(DenseStreamingTest, batches) {
+    dense::StreamingTable<int, std::string> table({.batch_rows = 3});
+    auto fst = table.insert(1, "one");
+    table.insert(2, "two");
+    ASSERT_EQ(table.latest()->count(), 0);
+    ASSERT_EQ(table.pending(), 2);
+    ASSERT_EQ(table.writer().count(), 2);
+
+    table.insert(3, "three");
+    auto published = table.latest();
+    ASSERT_EQ(published->count(), 3);
+    ASSERT_EQ(table.pending(), 0);
+
+    ASSERT_TRUE(table.remove(fst));
+    ASSERT_FALSE(table.remove(fst));
+    table.publish();
+    // held snapshot stays unchanged
+    ASSERT_EQ(*published->try_get<std::string>(fst), "one");
+    ASSERT_EQ(table.latest()->count(), 2);
+    ASSERT_EQ(table.latest()->try_get<int>(fst), nullptr);
+}
+
+TEST_F(DenseStreamingTest, interval) {
+    dense::StreamingTable<int> table({.batch_rows = 0, .interval = std::chrono::milliseconds{1}});
+    table.insert(1);
+    table.maybe_publish();
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    ASSERT_EQ(table.latest()->count(), 0);
+    table.maybe_publish();
+    ASSERT_EQ(table.latest()->count(), 1);
+}
+
+TEST_F(DenseStreamingTest, retired_on_next_publish) {
+    dense::StreamingTable<int> table({.batch_rows = 0});
+    table.insert(1);
+    table.publish();
+    std::weak_ptr<const dense::Snapshot<int>> fst = table.latest();
+    table.insert(2);
+    table.publish();
+    // old slot is reclaimed only when the next publish reuses it
+    ASSERT_FALSE(fst.expired());
+    ASSERT_EQ(table.latest()->count(), 2);
+    table.insert(3);
+    table.publish();
+    ASSERT_TRUE(fst.expired());
+    ASSERT_EQ(table.latest()->count(), 3);
+}
+
+TEST_F(DenseStreamingTest, concurrent_readers) {
+    constexpr int ROWS = 20000;
+    constexpr int BATCH = 100;
+    dense::StreamingTable<int> table({.batch_rows = BATCH});
+    std::atomic<bool> done = false;
+    std::atomic<int> failures = 0;
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            uint32_t last = 0;
+            while (!done) {
+                auto snapshot = table.latest();
+                // whole batches only, never going back
+                uint32_t count = snapshot->count();
+                int64_t sum = 0;
+                snapshot->for_each<int>([&](Id, const int &value) { sum += value; });
+                failures += count % BATCH != 0 || count < last || sum != int64_t{count} * (count - 1) / 2;
+                last = count;
+            }
+        });
+    }
+    for (int i = 0; i < ROWS; ++i) {
+        table.insert(i);
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    ASSERT_EQ(failures, 0);
+    ASSERT_EQ(table.latest()->count(), ROWS);
+}
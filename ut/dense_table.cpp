@@ -2,6 +2,9 @@
 #include <gtest/gtest.h>
 #include <tablez/dense/table.h>
 
+#include <stdexcept>
+#include <string>
+
 using namespace testing;
 
 class DenseTableTest : public Test {};
@@ -80,3 +83,259 @@ TEST_F(DenseTableTest, strings) {
     ASSERT_THAT(table.column<int>(), ColumnIs(std::array{1, 4, 3}));
     ASSERT_THAT(table.column<std::string>(), ColumnIs(std::array{"kek", "four", "three"}));
 }
+
+TEST_F(DenseTableTest, change_tracking) {
+    tablez::dense::Table<int, double> table;
+    table.track_changes<int>();
+
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 200; ++i) {
+        ids.push_back(table.insert(i, i * 0.5));
+    }
+
+    auto since = table.version();
+    std::vector<int> changed;
+    auto collect = [&changed](tablez::Id, const int &value) { changed.push_back(value); };
+
+    table.for_each_changed<int>(since, collect);
+    ASSERT_TRUE(changed.empty());
+
+    *table.try_get<int>(ids[150]) = -150;
+    *table.try_get<double>(ids[10]) = -1.0;  // other column
+    table.for_each_changed<int>(since, collect);
+    ASSERT_EQ(changed.size(), 64);  // chunk of rows [128, 192)
+    ASSERT_THAT(changed, Contains(-150));
+
+    // last row is moved into removed one's place, thus its new row is reported
+    since = table.version();
+    changed.clear();
+    ASSERT_TRUE(table.remove(ids[5]));
+    table.for_each_changed<int>(since, collect);
+    ASSERT_EQ(changed.size(), 64);
+    ASSERT_THAT(changed, Contains(199));
+    ASSERT_THAT(changed, Not(Contains(5)));
+
+    // untracked column is reported whole
+    changed.clear();
+    uint32_t doubles = 0;
+    table.for_each_changed<double>(table.version(), [&doubles](tablez::Id, const double &) { ++doubles; });
+    ASSERT_EQ(doubles, table.count());
+}
+
+TEST_F(DenseTableTest, aggregates) {
+    tablez::dense::Table<int, std::string> table;
+    table.insert(5, "five");
+    table.track_aggregate<int>();
+
+    auto one = table.insert(1, "one");
+    auto nine = table.insert(9, "nine");
+    table.insert(3, "three");
+
+    const auto &aggregate = table.aggregate<int>();
+    ASSERT_EQ(aggregate.count(), 4);
+    ASSERT_EQ(aggregate.sum(), 18);
+    ASSERT_EQ(aggregate.min(), 1);
+    ASSERT_EQ(aggregate.max(), 9);
+
+    ASSERT_TRUE(table.remove(one));
+    ASSERT_TRUE(aggregate.stale());
+    ASSERT_EQ(table.aggregate<int>().min(), 3);
+    ASSERT_EQ(table.aggregate<int>().sum(), 17);
+
+    ASSERT_TRUE(table.set<int>(nine, 7));
+    ASSERT_FALSE(table.set<int>(one, 100));
+    ASSERT_EQ(table.aggregate<int>().sum(), 15);
+    ASSERT_EQ(table.aggregate<int>().max(), 7);
+
+    *table.try_get<int>(nine) = 20;
+    ASSERT_EQ(table.aggregate<int>().max(), 20);
+    ASSERT_EQ(table.aggregate<int>().count(), 3);
+
+    for (auto [_, value] : table.column<int>()) {
+        value = -value;
+    }
+    ASSERT_EQ(table.aggregate<int>().min(), -20);
+    ASSERT_EQ(table.aggregate<int>().sum(), -28);
+}
+
+TEST_F(DenseTableTest, get_many) {
+    tablez::dense::Table<int, std::string> table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+    ASSERT_TRUE(table.remove(ids[51]));
+
+    std::vector<tablez::Id> batch;
+    for (int i = 99; i >= 0; i -= 7) {
+        batch.push_back(ids[i]);
+    }
+    batch.push_back(ids[51]);
+    batch.emplace_back(2, 1'000'000);  // out of capacity
+
+    std::array<bool, 17> found;
+    std::vector<int> ints(batch.size(), -1);
+    std::vector<std::string> strings(batch.size());
+    auto found_count = table.get_many<int, std::string>(batch, found, ints, strings);
+    ASSERT_EQ(found_count, 15);
+
+    for (size_t i = 0; i < 15; ++i) {
+        ASSERT_TRUE(found[i]);
+        ASSERT_EQ(ints[i], 99 - 7 * i);
+        ASSERT_EQ(strings[i], std::to_string(99 - 7 * i));
+    }
+    ASSERT_FALSE(found[15]);
+    ASSERT_FALSE(found[16]);
+    ASSERT_EQ(ints[15], -1);
+}
+
+TEST_F(DenseTableTest, shrink) {
+    tablez::dense::Table<int, std::string> table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+    ASSERT_EQ(table.capacity(), 1024);
+    for (int i = 10; i < 1000; ++i) {
+        ASSERT_TRUE(table.remove(ids[i]));
+    }
+
+    table.shrink_to_fit();
+    ASSERT_EQ(table.capacity(), 10);
+    ASSERT_THAT(table.column<int>(), ColumnIs(std::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    // stale Ids of dropped slots don't come back to life after growth
+    for (int i = 0; i < 1000; ++i) {
+        table.insert(-i, "");
+    }
+    for (int i = 10; i < 1000; ++i) {
+        ASSERT_EQ(table.try_get<int>(ids[i]), nullptr);
+        ASSERT_FALSE(table.remove(ids[i]));
+    }
+    ASSERT_EQ(*table.try_get<std::string>(ids[9]), "9");
+}
+
+TEST_F(DenseTableTest, shrink_policy) {
+    tablez::dense::Table<int> table;
+    table.set_shrink_policy({.low_water = 0.25, .min_capacity = 16});
+
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 1024; ++i) {
+        ids.push_back(table.insert(i));
+    }
+    // newest rows go first, thus the highest slots get freed
+    while (table.count() > 100) {
+        ASSERT_TRUE(table.remove(ids.back()));
+        ids.pop_back();
+    }
+    ASSERT_LE(table.capacity(), 512);
+    ASSERT_GE(table.capacity(), 200);
+
+    while (!ids.empty()) {
+        ASSERT_TRUE(table.remove(ids.back()));
+        ids.pop_back();
+    }
+    ASSERT_EQ(table.capacity(), 16);
+}
+
+TEST_F(DenseTableTest, clone_append_merge) {
+    tablez::dense::Table<int, std::string> table;
+    auto fst = table.insert(1, "one");
+    auto sec = table.insert(2, "two");
+    table.insert(3, "three");
+    table.remove(sec);
+    table.track_aggregate<int>();
+
+    auto copy = table.clone(4);
+    ASSERT_EQ(copy.count(), 2);
+    ASSERT_EQ(*copy.try_get<std::string>(fst), "one");
+    ASSERT_FALSE(copy.contains(sec));
+    ASSERT_EQ(copy.aggregate<int>().sum(), 4);
+    copy.set<int>(fst, 10);
+    ASSERT_EQ(*table.try_get<int>(fst), 1);
+
+    tablez::dense::Table<int, std::string> staging;
+    auto fth = staging.insert(4, "four");
+    auto fif = staging.insert(5, "five");
+
+    tablez::IdRemap remap;
+    ASSERT_EQ(table.merge(staging, &remap), 2);
+    ASSERT_EQ(staging.count(), 2);
+    ASSERT_EQ(table.count(), 4);
+    ASSERT_EQ(remap.size(), 2);
+    for (auto [from, to] : remap) {
+        ASSERT_EQ(*table.try_get<std::string>(to), *staging.try_get<std::string>(from));
+    }
+
+    remap.clear();
+    ASSERT_EQ(copy.append(std::move(staging), &remap), 2);
+    ASSERT_EQ(staging.count(), 0);
+    ASSERT_FALSE(staging.contains(fth) || staging.contains(fif));
+    ASSERT_EQ(copy.count(), 4);
+    ASSERT_EQ(copy.aggregate<int>().sum(), 22);
+    ASSERT_THAT(remap, UnorderedElementsAre(Pair(fth, _), Pair(fif, _)));
+    for (auto [from, to] : remap) {
+        ASSERT_EQ(*copy.try_get<int>(to), from == fth ? 4 : 5);
+    }
+
+    auto again = staging.insert(6, "six");
+    ASSERT_NE(again, fth);
+    ASSERT_NE(again, fif);
+    ASSERT_EQ(staging.count(), 1);
+
+    copy.clear();
+    ASSERT_EQ(copy.count(), 0);
+    ASSERT_FALSE(copy.contains(fst));
+    ASSERT_EQ(copy.aggregate<int>().sum(), 0);
+}
+
+struct CopyThrows {
+    static inline int alive = 0;
+    static inline int copies_left = 1 << 30;
+
+    int value;
+
+    CopyThrows(int value) : value{value} { ++alive; }
+    CopyThrows(const CopyThrows &rhs) : value{rhs.value} {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy");
+        }
+        ++alive;
+    }
+    CopyThrows(CopyThrows &&rhs) noexcept : value{rhs.value} { ++alive; }
+    CopyThrows &operator=(const CopyThrows &) = default;
+    CopyThrows &operator=(CopyThrows &&) noexcept = default;
+    ~CopyThrows() { --alive; }
+};
+
+TEST_F(DenseTableTest, clone_throws) {
+    {
+        tablez::dense::Table<std::string, CopyThrows> table;
+        auto fst = table.insert("one", CopyThrows{1});
+        table.insert("two", CopyThrows{2});
+        table.insert("three", CopyThrows{3});
+        ASSERT_EQ(CopyThrows::alive, 3);
+
+        // third copy throws, both copied values get destroyed and table stays as it was
+        CopyThrows::copies_left = 2;
+        ASSERT_THROW(table.clone(4), std::runtime_error);
+        ASSERT_EQ(CopyThrows::alive, 3);
+        ASSERT_EQ(table.count(), 3);
+
+        CopyThrows::copies_left = 1 << 30;
+        auto copy = table.clone(4);
+        ASSERT_EQ(CopyThrows::alive, 6);
+        ASSERT_EQ(copy.try_get<CopyThrows>(fst)->value, 1);
+        ASSERT_EQ(*copy.try_get<std::string>(fst), "one");
+
+        // same for merge, rows already there are kept
+        CopyThrows::copies_left = 2;
+        ASSERT_THROW(copy.merge(table), std::runtime_error);
+        ASSERT_EQ(CopyThrows::alive, 6);
+        ASSERT_EQ(copy.count(), 3);
+        CopyThrows::copies_left = 1 << 30;
+        ASSERT_EQ(copy.merge(table), 3);
+        ASSERT_EQ(CopyThrows::alive, 9);
+    }
+    ASSERT_EQ(CopyThrows::alive, 0);
+}
@@ -0,0 +1,107 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/dynamic_table.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace testing;
+using tablez::dense::ColumnType;
+using tablez::dense::Compare;
+using tablez::dense::DynamicSpan;
+using tablez::dense::DynamicTable;
+using tablez::dense::DynamicValue;
+
+class DynamicTableTest : public Test {};
+
+DynamicTable make_table() {
+    return DynamicTable({{"id", ColumnType::Int64}, {"price", ColumnType::Double}, {"name", ColumnType::String}});
+}
+
+TEST_F(DynamicTableTest, insert_remove_get) {
+    auto table = make_table();
+    ASSERT_EQ(table.find_column("price"), 1);
+    ASSERT_EQ(table.find_column("missing"), -1);
+
+    std::vector<DynamicValue> row{int64_t{1}, 1.5, std::string{"one"}};
+    auto fst = table.insert(row);
+    ASSERT_TRUE(fst.has_value());
+    row = {int64_t{2}, 2.5, std::string{"two"}};
+    auto sec = table.insert(row);
+    ASSERT_TRUE(sec.has_value());
+
+    // wrong type and wrong arity
+    row = {1, 2.5, std::string{"bad"}};
+    ASSERT_FALSE(table.insert(row).has_value());
+    row = {int64_t{1}, 2.5};
+    ASSERT_FALSE(table.insert(row).has_value());
+    ASSERT_EQ(table.count(), 2);
+
+    ASSERT_EQ(table.get(*sec, 2), DynamicValue{std::string{"two"}});
+    ASSERT_EQ(*table.try_get<double>(*fst, 1), 1.5);
+    ASSERT_EQ(table.try_get<int32_t>(*fst, 1), nullptr);
+    ASSERT_TRUE(table.set(*fst, 1, 3.0));
+    ASSERT_FALSE(table.set(*fst, 1, std::string{"bad"}));
+    ASSERT_EQ(*table.try_get<double>(*fst, 1), 3.0);
+
+    // column out of schema, e.g. not found
+    uint32_t missing = table.find_column("missing");
+    ASSERT_FALSE(table.has_column(missing));
+    ASSERT_EQ(table.try_get<double>(*fst, missing), nullptr);
+    ASSERT_FALSE(table.get(*fst, missing).has_value());
+    ASSERT_FALSE(table.set(*fst, missing, 1.0));
+    ASSERT_TRUE(table.values<double>(missing).empty());
+    ASSERT_FALSE(table.filter(missing, Compare::Less, 1.0).has_value());
+    ASSERT_TRUE(table.filter_if(missing, [](const auto &) { return true; }).empty());
+    ASSERT_FALSE(table.aggregate(missing).has_value());
+
+    ASSERT_TRUE(table.remove(*fst));
+    ASSERT_FALSE(table.remove(*fst));
+    ASSERT_FALSE(table.contains(*fst));
+    ASSERT_FALSE(table.get(*fst, 0).has_value());
+    ASSERT_THAT(std::vector(table.ids().begin(), table.ids().end()), ElementsAre(*sec));
+    auto names = table.values<std::string>(2);
+    ASSERT_THAT(std::vector(names.begin(), names.end()), ElementsAre("two"));
+}
+
+TEST_F(DynamicTableTest, insert_many_filter_aggregate) {
+    auto table = make_table();
+    std::vector<int64_t> ids{1, 2, 3, 4};
+    std::vector<double> prices{4.0, 1.0, 3.0, 2.0};
+    std::vector<std::string> names{"a", "b", "c", "d"};
+    std::vector<DynamicSpan> columns{std::span<const int64_t>{ids}, std::span<const double>{prices},
+                                     std::span<const std::string>{names}};
+    auto rows = table.insert_many(columns);
+    ASSERT_TRUE(rows.has_value());
+    std::vector<tablez::Id> inserted(rows->begin(), rows->end());
+    ASSERT_EQ(table.count(), 4);
+
+    columns[1] = std::span<const double>{prices.data(), 2};
+    ASSERT_FALSE(table.insert_many(columns).has_value());
+
+    ASSERT_THAT(*table.filter(1, Compare::GreaterEq, 3.0), ElementsAre(inserted[0], inserted[2]));
+    ASSERT_THAT(*table.filter(2, Compare::Equal, std::string{"d"}), ElementsAre(inserted[3]));
+    ASSERT_FALSE(table.filter(1, Compare::Less, int64_t{3}).has_value());
+    auto is_two = [](const auto &value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            return value == 2;
+        } else {
+            return false;
+        }
+    };
+    ASSERT_THAT(table.filter_if(0, is_two), ElementsAre(inserted[1]));
+
+    auto prices_agg = table.aggregate(1);
+    ASSERT_TRUE(prices_agg.has_value());
+    ASSERT_EQ(prices_agg->count, 4);
+    ASSERT_EQ(prices_agg->sum, DynamicValue{10.0});
+    ASSERT_EQ(prices_agg->min, DynamicValue{1.0});
+    ASSERT_EQ(prices_agg->max, DynamicValue{4.0});
+    ASSERT_EQ(table.aggregate(0)->sum, DynamicValue{int64_t{10}});
+    ASSERT_FALSE(table.aggregate(2).has_value());
+
+    size_t strings = table.visit_column(2, [](auto values) { return values.size(); });
+    ASSERT_EQ(strings, 4);
+}
@@ -0,0 +1,62 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/table.h>
+#include <tablez/group_by.h>
+#include <tablez/sparse/table.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+class GroupByTest : public Test {};
+
+template <class Table>
+void check_group_by(uint32_t threads) {
+    Table table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 50000; ++i) {
+        ids.push_back(table.insert(std::to_string(i % 1000), i % 97));
+    }
+    for (int i = 0; i < 50000; i += 7) {
+        table.remove(ids[i]);
+    }
+
+    struct Expected {
+        uint64_t count = 0;
+        int64_t sum = 0;
+        int min = 1000;
+        int max = -1;
+    };
+    std::map<std::string, Expected> expected;
+    for (int i = 0; i < 50000; ++i) {
+        if (i % 7 != 0) {
+            auto &e = expected[std::to_string(i % 1000)];
+            ++e.count;
+            e.sum += i % 97;
+            e.min = std::min(e.min, i % 97);
+            e.max = std::max(e.max, i % 97);
+        }
+    }
+
+    auto groups = tablez::group_by<std::string, int>(table, threads);
+    ASSERT_EQ(groups.size(), expected.size());
+    for (auto &group : groups) {
+        auto &e = expected.at(group.key);
+        ASSERT_EQ(group.count, e.count);
+        ASSERT_EQ(group.sum, e.sum);
+        ASSERT_EQ(group.min, e.min);
+        ASSERT_EQ(group.max, e.max);
+    }
+}
+
+TEST_F(GroupByTest, dense) {
+    check_group_by<tablez::dense::Table<std::string, int>>(1);
+    check_group_by<tablez::dense::Table<std::string, int>>(4);
+}
+
+TEST_F(GroupByTest, sparse) {
+    check_group_by<tablez::sparse::Table<std::string, int>>(1);
+    check_group_by<tablez::sparse::Table<std::string, int>>(3);
+}
@@ -0,0 +1,78 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/hybrid/table.h>
+
+#include <string>
+#include <vector>
+
+using namespace testing;
+using tablez::hybrid::Layout;
+
+class HybridTableTest : public Test {};
+
+TEST_F(HybridTableTest, migrate_keeps_ids) {
+    tablez::hybrid::Table<int, std::string> table;
+    table.set_migration_policy({.window = 0});
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+    for (int i = 0; i < 100; i += 3) {
+        ASSERT_TRUE(table.remove(ids[i]));
+    }
+
+    for (auto layout : {Layout::Sparse, Layout::Dense, Layout::Sparse}) {
+        table.migrate(layout);
+        ASSERT_EQ(table.layout(), layout);
+        ASSERT_EQ(table.count(), 66);
+        for (int i = 0; i < 100; ++i) {
+            auto *value = table.try_get<std::string>(ids[i]);
+            if (i % 3 == 0) {
+                ASSERT_EQ(value, nullptr);
+            } else {
+                ASSERT_NE(value, nullptr);
+                ASSERT_EQ(*value, std::to_string(i));
+            }
+        }
+    }
+
+    // reused slots get fresh generations, stale Ids stay invalid
+    auto id = table.insert(-1, "new");
+    ASSERT_FALSE(table.contains(ids[0]));
+    table.migrate(Layout::Dense);
+    ASSERT_EQ(*table.try_get<int>(id), -1);
+    ASSERT_FALSE(table.contains(ids[0]));
+    ASSERT_TRUE(table.remove(id));
+    ASSERT_FALSE(table.remove(id));
+    ASSERT_EQ(table.migrations(), 4);
+}
+
+TEST_F(HybridTableTest, adaptive) {
+    tablez::hybrid::Table<int> table;
+    table.set_migration_policy({.window = 64});
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(table.insert(i));
+    }
+    ASSERT_EQ(table.layout(), Layout::Dense);
+
+    // churn at high occupancy favours sparse
+    for (int i = 0; i < 256; ++i) {
+        ASSERT_TRUE(table.remove(ids[i]));
+        ids[i] = table.insert(i);
+    }
+    ASSERT_EQ(table.layout(), Layout::Sparse);
+
+    // mostly empty table favours dense
+    for (int i = 0; i < 900; ++i) {
+        ASSERT_TRUE(table.remove(ids[i]));
+    }
+    ASSERT_EQ(table.layout(), Layout::Dense);
+
+    int64_t sum = 0;
+    table.for_each<int>([&](tablez::Id id, int &value) {
+        ASSERT_EQ(id.idx(), ids[value].idx());
+        sum += value;
+    });
+    ASSERT_EQ(sum, (900 + 999) * 100 / 2);
+}
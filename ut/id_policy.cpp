@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <tablez/command_buffer.h>
+#include <tablez/dense/index.h>
+#include <tablez/dense/table.h>
+#include <tablez/id.h>
+#include <tablez/query.h>
+#include <tablez/sparse/index.h>
+#include <tablez/sparse/table.h>
+#include <tablez/view.h>
+
+#include <type_traits>
+
+using namespace testing;
+using namespace tablez;
+
+class IdPolicyTest : public Test {};
+
+TEST_F(IdPolicyTest, compact_id) {
+    CompactId id{2, CompactId::MAX_IDX};
+    ASSERT_EQ(id.gen(), 2);
+    ASSERT_EQ(id.idx(), (1u << 24) - 1);
+    ASSERT_FALSE(id.is_empty());
+
+    CompactId last{255, 7};
+    ASSERT_TRUE(last.is_empty());
+    last.make_gen_valid();
+    ASSERT_EQ(last.gen(), 0);
+    ASSERT_EQ(last.idx(), 7);
+    ASSERT_FALSE(last.is_empty());
+
+    ASSERT_EQ(CompactId::next_gen(255), 0);
+    ASSERT_EQ(Id::next_gen(UINT32_MAX), 0);
+}
+
+TEST_F(IdPolicyTest, dense_compact_index) {
+    dense::CompactIndex index;
+
+    auto fst = index.push_realloc();
+    auto sec = index.push_realloc();
+    ASSERT_EQ(fst.gen(), 2);
+    ASSERT_EQ(sec.idx(), 1);
+
+    // slot 0 goes through all generations, its Ids are told apart until generation wraps around
+    CompactId id = fst;
+    for (uint32_t i = 0; i < 127; ++i) {
+        ASSERT_EQ(index.try_remove(id), 0);
+        ASSERT_EQ(index.try_get_idx(id), std::nullopt);
+        id = index.push_realloc();
+        ASSERT_EQ(id.idx(), 0);
+        ASSERT_NE(id.gen(), fst.gen());
+        ASSERT_EQ(index.try_get_idx(id), 1);
+        ASSERT_EQ(index.try_get_idx(sec), 0);
+        ASSERT_EQ(index.try_remove(sec), 0);
+        sec = index.push_realloc();
+    }
+    ASSERT_EQ(id.gen(), 0);
+    ASSERT_EQ(index.try_remove(id), 0);
+    ASSERT_EQ(index.push_realloc(), fst);
+
+    index.dealloc();
+}
+
+TEST_F(IdPolicyTest, sparse_compact_index) {
+    auto index = sparse::CompactIndex::with_capacity(4);
+
+    auto id = index.push_unchecked(3);
+    ASSERT_EQ(id, CompactId(2, 3));
+    ASSERT_TRUE(index.is_set(3));
+    for (uint32_t i = 0; i < 127; ++i) {
+        ASSERT_TRUE(index.try_remove(id));
+        ASSERT_FALSE(index.try_remove(id));
+        id = index.push_unchecked(3);
+    }
+    ASSERT_EQ(id.gen(), 0);
+    ASSERT_EQ(index.count(), 1);
+    ASSERT_EQ(*index.begin(), id);
+
+    index.dealloc();
+}
+
+template <class Table>
+void check_compact_table() {
+    static_assert(std::is_same_v<typename Table::Id, CompactId>);
+    Table table;
+    std::vector<CompactId> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(table.insert(i));
+    }
+    ASSERT_TRUE(table.remove(ids[10]));
+    ASSERT_FALSE(table.contains(ids[10]));
+    ASSERT_EQ(*table.template try_get<int>(ids[20]), 20);
+
+    ASSERT_EQ(from(table).template where<int>(tablez::_ >= 90).count(), 10);
+    uint32_t joined = 0;
+    View(table, table).template for_each<int>([&](CompactId id, int &value) {
+        ASSERT_EQ(table.template try_get<int>(id), &value);
+        ++joined;
+    });
+    ASSERT_EQ(joined, 99);
+
+    CommandBuffer<Table> commands;
+    commands.remove(ids[0]);
+    commands.insert(1000);
+    auto inserted = commands.flush(table);
+    ASSERT_EQ(inserted.size(), 1);
+    ASSERT_EQ(*table.template try_get<int>(inserted[0]), 1000);
+    ASSERT_EQ(table.count(), 99);
+
+    Table rhs;
+    rhs.insert(2000);
+    BasicIdRemap<CompactIdPolicy> remap;
+    ASSERT_EQ(table.merge(rhs, &remap), 1);
+    ASSERT_EQ(*table.template try_get<int>(remap[0].second), 2000);
+}
+
+TEST_F(IdPolicyTest, compact_tables) {
+    static_assert(sizeof(dense::CompactTable<int>::Id) == 4 && sizeof(sparse::CompactTable<int>::Id) == 4);
+    check_compact_table<dense::CompactTable<int>>();
+    check_compact_table<sparse::CompactTable<int>>();
+}
@@ -0,0 +1,45 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/query.h>
+
+#include <vector>
+
+using tablez::_;
+
+class QueryTest : public testing::Test {};
+
+template <class Table>
+void check_query(Table &table) {
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(table.insert(i, i * 0.01, i % 2 == 0));
+    }
+    for (int i = 0; i < 100; i += 10) {
+        table.remove(ids[i]);
+    }
+
+    ASSERT_EQ(tablez::from(table).count(), 90);
+    ASSERT_EQ(tablez::from(table).template where<double>(_ > 0.5).count(), 45);
+    ASSERT_EQ(tablez::from(table).template where<double>(_ > 0.5).template select<int>().sum(), 3375);
+    ASSERT_EQ(tablez::from(table).template where<int>(_ < 10 || _ >= 95).template where<bool>(_ == true).count(), 6);
+    ASSERT_DOUBLE_EQ(tablez::from(table).template where<int>(_ >= 20 && _ < 30).template select<double>().sum(), 2.25);
+
+    std::vector<int> seen;
+    tablez::from(table).template where<int>(_ < 5).template select<int, bool>().for_each(
+        [&](tablez::Id id, const int &value, const bool &even) {
+            ASSERT_EQ(id, ids[value]);
+            ASSERT_EQ(even, value % 2 == 0);
+            seen.push_back(value);
+        });
+    ASSERT_THAT(seen, testing::UnorderedElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(QueryTest, dense) {
+    tablez::dense::Table<int, double, bool> table;
+    check_query(table);
+}
+
+TEST_F(QueryTest, sparse) {
+    tablez::sparse::Table<int, double, bool> table;
+    check_query(table);
+}
@@ -2,6 +2,9 @@
 #include <gtest/gtest.h>
 #include <tablez/sparse/table.h>
 
+#include <stdexcept>
+#include <string>
+
 using namespace testing;
 
 class SparseTableTest : public Test {};
@@ -79,3 +82,268 @@ TEST_F(SparseTableTest, strings) {
     ASSERT_THAT(table.column<int>().range(), ColumnIs(std::array{1, 3, 4}));
     ASSERT_THAT(table.column<std::string>().range(), ColumnIs(std::array{"kek", "three", "four"}));
 }
+
+TEST_F(SparseTableTest, change_tracking) {
+    tablez::sparse::Table<int, double> table;
+    table.track_changes<int>();
+
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 200; ++i) {
+        ids.push_back(table.insert(i, i * 0.5));
+    }
+
+    auto since = table.version();
+    std::vector<int> changed;
+    auto collect = [&changed](tablez::Id, const int &value) { changed.push_back(value); };
+
+    *table.try_get<int>(ids[70]) = -70;
+    ASSERT_TRUE(table.remove(ids[3]));
+    ASSERT_EQ(table.try_get<int>(ids[3]), nullptr);
+    table.for_each_changed<int>(since, collect);
+    ASSERT_EQ(changed.size(), 127);  // slots [0, 128) without removed one
+    ASSERT_THAT(changed, Contains(-70));
+    ASSERT_THAT(changed, Not(Contains(3)));
+
+    since = table.version();
+    changed.clear();
+    auto id = table.insert(1000, 0.0);
+    table.for_each_changed<int>(since, collect);
+    ASSERT_EQ(id.idx(), ids[3].idx());
+    ASSERT_THAT(changed, Contains(1000));
+    ASSERT_EQ(changed.size(), 64);
+}
+
+TEST_F(SparseTableTest, aggregates) {
+    tablez::sparse::Table<double, std::string> table;
+    table.track_aggregate<double>();
+
+    auto low = table.insert(-1.5, "low");
+    table.insert(2.5, "mid");
+    auto high = table.insert(4.0, "high");
+
+    ASSERT_EQ(table.aggregate<double>().count(), 3);
+    ASSERT_DOUBLE_EQ(table.aggregate<double>().sum(), 5.0);
+    ASSERT_EQ(table.aggregate<double>().min(), -1.5);
+
+    ASSERT_TRUE(table.remove(high));
+    ASSERT_EQ(table.aggregate<double>().max(), 2.5);
+
+    ASSERT_TRUE(table.set<double>(low, 0.5));
+    ASSERT_DOUBLE_EQ(table.aggregate<double>().sum(), 3.0);
+    ASSERT_EQ(table.aggregate<double>().min(), 0.5);
+
+    ASSERT_TRUE(table.remove(low));
+    table.for_each_row([](tablez::Id, double &value, std::string &) { value = 10.0; });
+    ASSERT_DOUBLE_EQ(table.aggregate<double>().sum(), 10.0);
+    ASSERT_EQ(table.aggregate<double>().count(), 1);
+
+    table.column<double>().for_each([](tablez::Id, double &value) { value = -3.0; });
+    ASSERT_EQ(table.aggregate<double>().max(), -3.0);
+}
+
+TEST_F(SparseTableTest, get_many) {
+    tablez::sparse::Table<int, double> table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 40; ++i) {
+        ids.push_back(table.insert(i, i * 0.5));
+    }
+    ASSERT_TRUE(table.remove(ids[3]));
+
+    std::vector<tablez::Id> batch{ids[0], ids[3], ids[39], tablez::Id{2, 100}, ids[20]};
+    std::array<bool, 5> found;
+    std::array<double, 5> doubles{};
+    ASSERT_EQ(table.get_many<double>(batch, found, doubles), 3);
+    ASSERT_THAT(found, ElementsAre(true, false, true, false, true));
+    ASSERT_EQ(doubles[0], 0.0);
+    ASSERT_EQ(doubles[2], 19.5);
+    ASSERT_EQ(doubles[4], 10.0);
+}
+
+TEST_F(SparseTableTest, lowest_first_policy) {
+    tablez::sparse::Table<int> table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(table.insert(i));
+    }
+    for (int i : {70, 10, 40, 99}) {
+        ASSERT_TRUE(table.remove(ids[i]));
+    }
+
+    // LIFO reuses the most recently freed slot
+    auto lifo = table.insert(-1);
+    ASSERT_EQ(lifo.idx(), 99);
+
+    table.set_slot_policy(tablez::sparse::SlotPolicy::LowestFirst);
+    ASSERT_EQ(table.insert(-2).idx(), 10);
+    ASSERT_EQ(table.insert(-3).idx(), 40);
+    ASSERT_TRUE(table.remove(ids[5]));
+    ASSERT_EQ(table.insert(-4).idx(), 5);
+    ASSERT_EQ(table.insert(-5).idx(), 70);
+    ASSERT_EQ(table.insert(-6).idx(), 100);  // grows
+    ASSERT_EQ(table.count(), 101);
+
+    ASSERT_TRUE(table.remove(lifo));
+    table.set_slot_policy(tablez::sparse::SlotPolicy::Lifo);
+    ASSERT_EQ(table.insert(-7).idx(), 99);
+}
+
+TEST_F(SparseTableTest, compact) {
+    tablez::sparse::Table<int, std::string> table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 10; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+    for (int i : {1, 2, 4, 8}) {
+        ASSERT_TRUE(table.remove(ids[i]));
+    }
+
+    auto remap = table.compact();
+    ASSERT_EQ(remap.size(), 3);  // 9, 7 and 6 move into 1, 2 and 4
+    ASSERT_EQ(remap.capacity(), 3);  // reserved up front
+    for (auto [old_id, new_id] : remap) {
+        ASSERT_EQ(table.try_get<int>(old_id), nullptr);
+        ASSERT_LT(new_id.idx(), 6);
+        ASSERT_EQ(std::to_string(*table.try_get<int>(new_id)), *table.try_get<std::string>(new_id));
+    }
+    ASSERT_EQ(table.count(), 6);
+    ASSERT_THAT(table.column<int>().range(), ColumnIs(std::array{0, 9, 7, 3, 6, 5}));
+
+    ASSERT_EQ(table.insert(10, "10").idx(), 6);
+}
+
+TEST_F(SparseTableTest, shrink) {
+    tablez::sparse::Table<int, std::string> table;
+    table.set_slot_policy(tablez::sparse::SlotPolicy::LowestFirst);
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(table.insert(i, std::to_string(i)));
+    }
+    ASSERT_EQ(table.capacity(), 1024);
+    for (int i = 5; i < 1000; ++i) {
+        if (i != 20) {
+            ASSERT_TRUE(table.remove(ids[i]));
+        }
+    }
+
+    table.shrink_to_fit();
+    ASSERT_EQ(table.capacity(), 21);  // slot 20 is still occupied
+    ASSERT_THAT(table.column<int>().range(), ColumnIs(std::array{0, 1, 2, 3, 4, 20}));
+
+    for (int i = 0; i < 1000; ++i) {
+        table.insert(-i, "");
+    }
+    for (int i = 21; i < 1000; ++i) {
+        ASSERT_EQ(table.try_get<int>(ids[i]), nullptr);
+    }
+    ASSERT_EQ(*table.try_get<std::string>(ids[20]), "20");
+}
+
+TEST_F(SparseTableTest, shrink_policy) {
+    tablez::sparse::Table<int> table;
+    table.set_slot_policy(tablez::sparse::SlotPolicy::LowestFirst);
+    table.set_shrink_policy({.low_water = 0.25});
+
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 1024; ++i) {
+        ids.push_back(table.insert(i));
+    }
+    while (table.count() > 10) {
+        ASSERT_TRUE(table.remove(ids.back()));
+        ids.pop_back();
+    }
+    ASSERT_LE(table.capacity(), 64);
+    ASSERT_EQ(table.count(), 10);
+}
+
+TEST_F(SparseTableTest, clone_append_merge) {
+    tablez::sparse::Table<int, std::string> table;
+    auto fst = table.insert(1, "one");
+    auto sec = table.insert(2, "two");
+    table.insert(3, "three");
+    table.remove(sec);
+    table.track_aggregate<int>();
+
+    auto copy = table.clone(4);
+    ASSERT_EQ(copy.count(), 2);
+    ASSERT_EQ(*copy.try_get<std::string>(fst), "one");
+    ASSERT_FALSE(copy.contains(sec));
+    ASSERT_EQ(copy.aggregate<int>().sum(), 4);
+    copy.set<int>(fst, 10);
+    ASSERT_EQ(*table.try_get<int>(fst), 1);
+
+    tablez::sparse::Table<int, std::string> staging;
+    auto fth = staging.insert(4, "four");
+    auto fif = staging.insert(5, "five");
+
+    tablez::IdRemap remap;
+    ASSERT_EQ(table.merge(staging, &remap), 2);
+    ASSERT_EQ(staging.count(), 2);
+    ASSERT_EQ(table.count(), 4);
+    ASSERT_EQ(remap.size(), 2);
+    for (auto [from, to] : remap) {
+        ASSERT_EQ(*table.try_get<std::string>(to), *staging.try_get<std::string>(from));
+    }
+
+    remap.clear();
+    ASSERT_EQ(copy.append(std::move(staging), &remap), 2);
+    ASSERT_EQ(staging.count(), 0);
+    ASSERT_FALSE(staging.contains(fth) || staging.contains(fif));
+    ASSERT_EQ(copy.count(), 4);
+    ASSERT_EQ(copy.aggregate<int>().sum(), 22);
+    ASSERT_THAT(remap, UnorderedElementsAre(Pair(fth, _), Pair(fif, _)));
+    for (auto [from, to] : remap) {
+        ASSERT_EQ(*copy.try_get<int>(to), from == fth ? 4 : 5);
+    }
+
+    auto again = staging.insert(6, "six");
+    ASSERT_NE(again, fth);
+    ASSERT_NE(again, fif);
+    ASSERT_EQ(staging.count(), 1);
+
+    copy.clear();
+    ASSERT_EQ(copy.count(), 0);
+    ASSERT_FALSE(copy.contains(fst));
+    ASSERT_EQ(copy.aggregate<int>().sum(), 0);
+}
+
+struct CopyThrows {
+    static inline int alive = 0;
+    static inline int copies_left = 1 << 30;
+
+    int value;
+
+    CopyThrows(int value) : value{value} { ++alive; }
+    CopyThrows(const CopyThrows &rhs) : value{rhs.value} {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy");
+        }
+        ++alive;
+    }
+    CopyThrows(CopyThrows &&rhs) noexcept : value{rhs.value} { ++alive; }
+    CopyThrows &operator=(const CopyThrows &) = default;
+    CopyThrows &operator=(CopyThrows &&) noexcept = default;
+    ~CopyThrows() { --alive; }
+};
+
+TEST_F(SparseTableTest, clone_throws) {
+    {
+        tablez::sparse::Table<std::string, CopyThrows> table;
+        auto fst = table.insert("one", CopyThrows{1});
+        table.insert("two", CopyThrows{2});
+        table.insert("three", CopyThrows{3});
+        ASSERT_EQ(CopyThrows::alive, 3);
+
+        // third copy throws, both copied values get destroyed and table stays as it was
+        CopyThrows::copies_left = 2;
+        ASSERT_THROW(table.clone(4), std::runtime_error);
+        ASSERT_EQ(CopyThrows::alive, 3);
+        ASSERT_EQ(table.count(), 3);
+
+        CopyThrows::copies_left = 1 << 30;
+        auto copy = table.clone(4);
+        ASSERT_EQ(CopyThrows::alive, 6);
+        ASSERT_EQ(copy.try_get<CopyThrows>(fst)->value, 1);
+        ASSERT_EQ(*copy.try_get<std::string>(fst), "one");
+    }
+    ASSERT_EQ(CopyThrows::alive, 0);
+}
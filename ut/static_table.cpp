@@ -0,0 +1,136 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/static_table.h>
+#include <tablez/sparse/static_table.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+
+class StaticTableTest : public Test {};
+
+template <class Table>
+std::vector<std::pair<int, std::string>> rows_of(Table &table) {
+    std::vector<std::pair<int, std::string>> rows;
+    table.for_each_row([&](tablez::Id, int &value, std::string &name) { rows.emplace_back(value, name); });
+    return rows;
+}
+
+template <class Table>
+void check_base() {
+    Table table;
+    ASSERT_EQ(table.count(), 0);
+    ASSERT_EQ(table.capacity(), 4);
+
+    auto fst = table.insert(1, "one");
+    auto sec = table.insert(2, "two");
+    auto thd = table.insert(3, "three");
+    auto fth = table.insert(4, "four");
+    ASSERT_TRUE(table.full());
+    ASSERT_EQ(*table.template try_get<std::string>(sec), "two");
+
+    ASSERT_TRUE(table.remove(sec));
+    ASSERT_FALSE(table.remove(sec));
+    ASSERT_FALSE(table.contains(sec));
+    ASSERT_EQ(table.template try_get<int>(sec), nullptr);
+    ASSERT_TRUE(table.contains(fst) && table.contains(thd) && table.contains(fth));
+
+    auto sec_ = table.insert(5, "five");
+    ASSERT_EQ(sec_.idx(), sec.idx());
+    ASSERT_NE(sec_, sec);
+    ASSERT_TRUE(table.template set<int>(sec_, 6));
+    ASSERT_THAT(rows_of(table), UnorderedElementsAre(Pair(1, "one"), Pair(6, "five"), Pair(3, "three"),
+                                                     Pair(4, "four")));
+
+    Table copy = table;
+    ASSERT_TRUE(copy.remove(fst));
+    ASSERT_EQ(copy.count(), 3);
+    ASSERT_EQ(table.count(), 4);
+
+    Table moved = std::move(copy);
+    ASSERT_THAT(rows_of(moved), UnorderedElementsAre(Pair(6, "five"), Pair(3, "three"), Pair(4, "four")));
+    ASSERT_EQ(*moved.template try_get<std::string>(fth), "four");
+
+    moved = table;
+    ASSERT_EQ(moved.count(), 4);
+    ASSERT_TRUE(moved.contains(fst));
+
+    table.clear();
+    ASSERT_EQ(table.count(), 0);
+    ASSERT_FALSE(table.contains(fst));
+    auto again = table.insert(7, "seven");
+    ASSERT_EQ(*table.template try_get<int>(again), 7);
+    ASSERT_FALSE(table.contains(fst) || table.contains(sec_) || table.contains(thd) || table.contains(fth));
+}
+
+TEST_F(StaticTableTest, dense) { check_base<tablez::dense::StaticTable<4, int, std::string>>(); }
+
+TEST_F(StaticTableTest, sparse) { check_base<tablez::sparse::StaticTable<4, int, std::string>>(); }
+
+TEST_F(StaticTableTest, dense_values) {
+    tablez::dense::StaticTable<8, int, double> table;
+    auto fst = table.insert(1, 0.5);
+    table.insert(2, 1.5);
+    table.insert(3, 2.5);
+    table.remove(fst);
+    auto values = table.values<int>();
+    ASSERT_THAT(std::vector<int>(values.begin(), values.end()), ElementsAre(3, 2));
+    ASSERT_EQ(table.ids().size(), 2);
+    ASSERT_EQ(*table.try_get<double>(table.ids()[0]), 2.5);
+}
+
+// counts live values, copy throws once copies_left runs out
+struct Tracked {
+    static inline int alive = 0;
+    static inline int copies_left = 1 << 30;
+
+    int value;
+
+    Tracked(int value) : value{value} { ++alive; }
+    Tracked(const Tracked &rhs) : value{rhs.value} {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy");
+        }
+        ++alive;
+    }
+    Tracked(Tracked &&rhs) noexcept : value{rhs.value} { ++alive; }
+    Tracked &operator=(const Tracked &) = default;
+    Tracked &operator=(Tracked &&) noexcept = default;
+    ~Tracked() { --alive; }
+};
+
+template <class Table>
+void check_throwing_copy() {
+    {
+        Table table;
+        auto fst = table.insert(1, Tracked{10});
+        table.insert(2, Tracked{20});
+        table.insert(3, Tracked{30});
+        ASSERT_EQ(Tracked::alive, 3);
+
+        Tracked::copies_left = 2;  // the third value throws
+        ASSERT_THROW(Table{table}, std::runtime_error);
+        ASSERT_EQ(Tracked::alive, 3);
+
+        Table other;
+        other.insert(4, Tracked{40});
+        Tracked::copies_left = 1;
+        ASSERT_THROW(other = table, std::runtime_error);
+        ASSERT_EQ(other.count(), 1);
+        ASSERT_EQ(Tracked::alive, 4);
+
+        Tracked::copies_left = 1 << 30;
+        other = table;
+        ASSERT_EQ(other.template try_get<Tracked>(fst)->value, 10);
+        ASSERT_EQ(Tracked::alive, 6);
+    }
+    ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST_F(StaticTableTest, throwing_copy) {
+    check_throwing_copy<tablez::dense::StaticTable<4, int, Tracked>>();
+    check_throwing_copy<tablez::sparse::StaticTable<4, int, Tracked>>();
+}
@@ -0,0 +1,71 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/table.h>
+#include <tablez/sparse/table.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+class StatsTest : public Test {};
+
+template <class Table>
+void check_stats() {
+    Table table;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 3000; ++i) {
+        ids.push_back(table.insert(i, i * 0.5));
+    }
+    for (int i = 0; i < 3000; i += 2) {
+        ASSERT_TRUE(table.remove(ids[i]));
+    }
+    ASSERT_FALSE(table.remove(ids[0]));
+
+    auto stats = table.stats();
+    ASSERT_EQ(stats.count, 1500);
+    ASSERT_EQ(stats.capacity, table.capacity());
+    ASSERT_THAT(stats.column_bytes, ElementsAre(table.capacity() * sizeof(int), table.capacity() * sizeof(double)));
+    ASSERT_GT(stats.index_bytes, 0);
+    ASSERT_EQ(stats.block_occupancy.size(),
+              (table.capacity() + tablez::TableStats::OCCUPANCY_BLOCK - 1) / tablez::TableStats::OCCUPANCY_BLOCK);
+    uint32_t alive = 0;
+    for (uint32_t block : stats.block_occupancy) {
+        ASSERT_LE(block, tablez::TableStats::OCCUPANCY_BLOCK);
+        alive += block;
+    }
+    ASSERT_EQ(alive, 1500);
+
+    if constexpr (tablez::STATS_ENABLED) {
+        ASSERT_EQ(stats.inserts, 3000);
+        ASSERT_EQ(stats.removes, 1500);
+        ASSERT_EQ(stats.stale_removes, 1);
+        ASSERT_GT(stats.reallocs, 0);
+        ASSERT_GT(stats.bytes_moved, 0);
+    } else {
+        ASSERT_EQ(stats.inserts, 0);
+        ASSERT_EQ(stats.removes, 0);
+        ASSERT_EQ(stats.stale_removes, 0);
+        ASSERT_EQ(stats.reallocs, 0);
+    }
+
+    std::map<std::string, uint64_t> metrics;
+    stats.for_each_metric([&](const std::string &name, uint64_t value) { metrics[name] = value; });
+    ASSERT_EQ(metrics["count"], 1500);
+    ASSERT_EQ(metrics["column_bytes.1"], table.capacity() * sizeof(double));
+    ASSERT_TRUE(metrics.contains("block_occupancy.0"));
+}
+
+TEST_F(StatsTest, dense) { check_stats<tablez::dense::Table<int, double>>(); }
+
+TEST_F(StatsTest, sparse) { check_stats<tablez::sparse::Table<int, double>>(); }
+
+TEST_F(StatsTest, dense_rows_packed_at_front) {
+    tablez::dense::Table<int> table;
+    table.reserve_at_least(3000);
+    for (int i = 0; i < 1500; ++i) {
+        table.insert(i);
+    }
+    ASSERT_THAT(table.stats().block_occupancy, ElementsAre(1024, 476, 0));
+}
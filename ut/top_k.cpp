@@ -0,0 +1,71 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/table.h>
+#include <tablez/sparse/table.h>
+#include <tablez/top_k.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+class TopKTest : public Test {};
+
+template <class Table>
+void check_top_k(uint32_t threads) {
+    Table table;
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> dist{0, 1 << 20};
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 50000; ++i) {
+        ids.push_back(table.insert(dist(rng)));
+    }
+    for (int i = 0; i < 50000; i += 2) {
+        table.remove(ids[i]);
+    }
+    std::vector<int> values;
+    for (int i = 1; i < 50000; i += 2) {
+        values.push_back(*table.template try_get<int>(ids[i]));
+    }
+    std::sort(values.begin(), values.end());
+
+    auto top = tablez::top_k<int>(table, 10, std::greater<>{}, threads);
+    ASSERT_EQ(top.size(), 10);
+    for (uint32_t i = 0; i < top.size(); ++i) {
+        ASSERT_EQ(top[i].second, values[values.size() - 1 - i]);
+        ASSERT_EQ(*table.template try_get<int>(top[i].first), top[i].second);
+    }
+
+    auto bottom = tablez::top_k<int>(table, 100, std::less<>{}, threads);
+    ASSERT_EQ(bottom.size(), 100);
+    for (uint32_t i = 0; i < bottom.size(); ++i) {
+        ASSERT_EQ(bottom[i].second, values[i]);
+    }
+
+    ASSERT_EQ(tablez::top_k<int>(table, 100000).size(), values.size());
+    ASSERT_TRUE(tablez::top_k<int>(table, 0).empty());
+}
+
+TEST_F(TopKTest, dense) {
+    check_top_k<tablez::dense::Table<int>>(1);
+    check_top_k<tablez::dense::Table<int>>(4);
+}
+
+TEST_F(TopKTest, sparse) {
+    check_top_k<tablez::sparse::Table<int>>(1);
+    check_top_k<tablez::sparse::Table<int>>(3);
+}
+
+TEST_F(TopKTest, k_above_count) {
+    tablez::dense::Table<int> table;
+    for (int i = 0; i < 10000; ++i) {
+        table.insert(i);
+    }
+    auto top = tablez::top_k<int>(table, UINT32_MAX, std::greater<>{}, 2);
+    ASSERT_EQ(top.size(), table.count());
+    ASSERT_EQ(top.front().second, 9999);
+    ASSERT_EQ(top.back().second, 0);
+}
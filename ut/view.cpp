@@ -0,0 +1,62 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/dense/table.h>
+#include <tablez/sparse/table.h>
+#include <tablez/view.h>
+
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+class ViewTest : public Test {};
+
+struct Position {
+    float x;
+};
+
+struct Velocity {
+    float dx;
+};
+
+// both tables get the same Ids, then some rows are removed from one of them
+template <class PosTable, class VelTable>
+void check_view() {
+    PosTable positions;
+    VelTable velocities;
+    std::vector<tablez::Id> ids;
+    for (int i = 0; i < 1000; ++i) {
+        auto id = positions.insert(Position{float(i)}, std::to_string(i));
+        ASSERT_EQ(id, velocities.insert(Velocity{1.0f}));
+        ids.push_back(id);
+    }
+    for (int i = 0; i < 1000; i += 3) {
+        velocities.remove(ids[i]);
+    }
+    for (int i = 0; i < 1000; i += 5) {
+        positions.remove(ids[i]);
+    }
+
+    tablez::View view{positions, velocities};
+    ASSERT_EQ(view.count(), 1000 - 334 - 200 + 67);
+
+    uint32_t visited = 0;
+    view.template for_each<Position, Velocity, std::string>(
+        [&](tablez::Id id, Position &pos, Velocity &vel, std::string &name) {
+            ASSERT_EQ(pos.x, std::stof(name));
+            ASSERT_EQ(id, ids[std::stoi(name)]);
+            pos.x += vel.dx;
+            ++visited;
+        });
+    ASSERT_EQ(visited, view.count());
+    ASSERT_EQ(positions.template try_get<Position>(ids[1])->x, 2.0f);
+    ASSERT_EQ(positions.template try_get<Position>(ids[3])->x, 3.0f);
+}
+
+TEST_F(ViewTest, sparse) {
+    check_view<tablez::sparse::Table<Position, std::string>, tablez::sparse::Table<Velocity>>();
+}
+
+TEST_F(ViewTest, dense) { check_view<tablez::dense::Table<Position, std::string>, tablez::dense::Table<Velocity>>(); }
+
+TEST_F(ViewTest, mixed) { check_view<tablez::dense::Table<Position, std::string>, tablez::sparse::Table<Velocity>>(); }
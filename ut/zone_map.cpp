@@ -0,0 +1,150 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tablez/query.h>
+#include <tablez/view.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using testing::Test;
+using namespace tablez;
+
+class ZoneMapTest : public Test {};
+
+using Table = dense::Table<int64_t, double>;
+
+// bounds of every zone hold all of its values
+void check_bounds(Table &table) {
+    table.refresh_zones();
+    auto *zones = table.zone_map<int64_t>();
+    ASSERT_NE(zones, nullptr);
+    auto values = table.values<int64_t>();
+    for (uint32_t row = 0; row < values.size(); ++row) {
+        ASSERT_LE(zones->min(row >> ZONE_SHIFT), values[row]);
+        ASSERT_GE(zones->max(row >> ZONE_SHIFT), values[row]);
+    }
+}
+
+// same filter with a scan of every row
+int64_t scan_sum(const Table &table, int64_t lo, int64_t hi) {
+    int64_t sum = 0;
+    for (int64_t value : table.values<int64_t>()) {
+        sum += value >= lo && value < hi ? value : 0;
+    }
+    return sum;
+}
+
+TEST_F(ZoneMapTest, bounds) {
+    Table table;
+    ASSERT_EQ(table.zone_map<int64_t>(), nullptr);
+    std::vector<Id> ids;
+    for (int64_t i = 0; i < 5000; ++i) {
+        ids.push_back(table.insert(i, 0.0));
+    }
+    table.track_zones<int64_t>();
+    auto *zones = table.zone_map<int64_t>();
+    ASSERT_EQ(zones->min(0), 0);
+    ASSERT_EQ(zones->max(0), ZONE_ROWS - 1);
+    ASSERT_EQ(zones->max(4), 4999);
+
+    // last row moves into zone 0, zone 4 loses its max
+    ASSERT_TRUE(table.remove(ids[10]));
+    ASSERT_TRUE(table.zone_map<int64_t>()->dirty(4));
+    table.refresh_zones();
+    ASSERT_EQ(table.zone_map<int64_t>()->max(0), 4999);
+    ASSERT_EQ(table.zone_map<int64_t>()->max(4), 4998);
+
+    ASSERT_TRUE(table.set<int64_t>(ids[20], -5));
+    ASSERT_EQ(table.zone_map<int64_t>()->min(0), -5);
+    *table.try_get<int64_t>(ids[20]) = 20;
+    table.refresh_zones();
+    ASSERT_EQ(table.zone_map<int64_t>()->min(0), 0);
+    check_bounds(table);
+
+    table.track_zones<int64_t>(false);
+    ASSERT_EQ(table.zone_map<int64_t>(), nullptr);
+}
+
+TEST_F(ZoneMapTest, random_changes) {
+    Table table;
+    table.track_zones<int64_t>();
+    std::mt19937 rng{7};
+    std::vector<Id> ids;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            ids.push_back(table.insert(std::uniform_int_distribution<int64_t>{-1000, 1000}(rng), 0.0));
+        }
+        for (int i = 0; i < 400; ++i) {
+            size_t at = std::uniform_int_distribution<size_t>{0, ids.size() - 1}(rng);
+            table.remove(ids[at]);
+            ids[at] = ids.back();
+            ids.pop_back();
+        }
+        table.set<int64_t>(ids[round], round * 100);
+        check_bounds(table);
+    }
+    table.for_each<int64_t>([](Id, int64_t &value) { value *= 2; });
+    check_bounds(table);
+    table.merge(table.clone());
+    check_bounds(table);
+}
+
+TEST_F(ZoneMapTest, query_skips_zones) {
+    // sorted column, as time of appends
+    Table table;
+    for (int64_t i = 0; i < 100000; ++i) {
+        table.insert(i, i * 0.5);
+    }
+    auto query = [&] { return from(table).where<int64_t>(_ >= 40000 && _ < 41000).select<int64_t>().sum(); };
+    int64_t expected = scan_sum(table, 40000, 41000);
+    ASSERT_EQ(query(), expected);
+
+    table.track_zones<int64_t>();
+    table.track_zones<double>();
+    ASSERT_EQ(query(), expected);
+    ASSERT_EQ(from(table).where<int64_t>(_ == 77777).count(), 1);
+    ASSERT_EQ(from(table).where<int64_t>(_ < 0 || _ > 99990).count(), 9);
+    ASSERT_EQ(from(table).where<double>(_ < 10.0).where<int64_t>(_ > 5).count(), 14);
+    ASSERT_EQ(from(table).where<int64_t>(_ != 5).count(), 99999);
+
+    // value moved into a skipped zone gets found
+    table.set<int64_t>(table.ids()[3], 40500);
+    ASSERT_EQ(query(), expected + 40500);
+
+    // dirty zone gets scanned until refresh
+    table.remove(table.ids()[0]);  // zone 0 loses its min
+    ASSERT_TRUE(table.zone_map<int64_t>()->dirty(0));
+    ASSERT_EQ(query(), expected + 40500);
+    table.refresh_zones();
+    ASSERT_EQ(query(), expected + 40500);
+}
+
+TEST_F(ZoneMapTest, write_through_view) {
+    Table table;
+    for (int64_t i = 0; i < 10000; ++i) {
+        table.insert(i, 0.0);
+    }
+    table.track_zones<int64_t>();
+    auto query = [&] { return from(table).where<int64_t>(_ >= 20000).count(); };
+    ASSERT_EQ(query(), 0);
+
+    // zones of written column get dirty, thus scanned
+    View(table).for_each<int64_t>([](Id, int64_t &value) { value += 20000; });
+    ASSERT_EQ(query(), 10000);
+    table.refresh_zones();
+    ASSERT_EQ(query(), 10000);
+    check_bounds(table);
+}
+
+TEST_F(ZoneMapTest, nan) {
+    dense::Table<double> table;
+    table.track_zones<double>();
+    for (int i = 0; i < 3000; ++i) {
+        table.insert(i == 10 ? std::numeric_limits<double>::quiet_NaN() : i);
+    }
+    ASSERT_EQ(from(table).where<double>(_ > 2500.0).count(), 499);
+    ASSERT_EQ(from(table).where<double>(_ != 1.0).count(), 2999);
+    ASSERT_EQ(from(table).where<double>(_ < 100.0).count(), 99);
+}